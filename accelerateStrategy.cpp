@@ -17,78 +17,93 @@
 
 #include "accelerateStrategy.h"
 
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+/// Axis moved by a key and direction it drives the axis, indexed by ControlKeys::Id
+struct KeyAcceleration {
+	int power;
+	int direction;
+};
+
+/// Axes in the order of AccelerateStrategy::Power
+constexpr int axisX1 = 0;
+constexpr int axisY1 = 1;
+constexpr int axisX2 = 2;
+constexpr int axisY2 = 3;
+
+constexpr KeyAcceleration keyAccelerations[ControlKeys::count] = {
+	{axisY1, 1} // W
+	, {axisX1, -1} // A
+	, {axisY1, -1} // S
+	, {axisX1, 1} // D
+	, {axisX2, -1} // Left
+	, {axisY2, 1} // Up
+	, {axisX2, 1} // Right
+	, {axisY2, -1} // Down
+	, {axisX1, 0}
+	, {axisX1, 0}
+	, {axisX1, 0}
+	, {axisX1, 0}
+	, {axisX1, 0}
+};
+
+constexpr ControlKeys::Mask padKeys = ControlKeys::pad1Keys | ControlKeys::pad2Keys;
+
+/// Steepness of the exponential curve, power reaches 9% of maximum at a third of ramp time and half of it at 78%
+constexpr double exponentialSteepness = 3.0;
+
+/// Share of full power for given share of ramp time, both from 0 to 1
+double shape(AccelerateStrategy::Curve curve, double progress)
+{
+	switch (curve) {
+	case AccelerateStrategy::Curve::exponential:
+		return std::expm1(exponentialSteepness * progress) / std::expm1(exponentialSteepness);
+	case AccelerateStrategy::Curve::sCurve:
+		return progress * progress * (3.0 - 2.0 * progress);
+	case AccelerateStrategy::Curve::linear:
+		break;
+	}
+
+	return progress;
+}
+
+}
+
 AccelerateStrategy::AccelerateStrategy(int currentSpeed, QObject *parent)
 	: Strategy(parent)
+	, stopTimerForPad1(this)
+	, stopTimerForPad2(this)
+	, scheduler(this)
 	, speed(currentSpeed)
+	, rampTime(10 * currentSpeed)
 {
 
-	connect(&stopTimerForPad1, &QTimer::timeout, this, [this]() { stopTimerForPad1.stop(); stopPads(1); });
-	connect(&stopTimerForPad2, &QTimer::timeout, this, [this]() { stopTimerForPad2.stop(); stopPads(2); });
-	connect(&workTimer, &QTimer::timeout, this, &AccelerateStrategy::dealWithPads);
-
-	pad1 = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
-	pad2 = {Qt::Key_Left, Qt::Key_Right, Qt::Key_Up, Qt::Key_Down};
-	magicButtons = {Qt::Key_1, Qt::Key_2, Qt::Key_3, Qt::Key_4, Qt::Key_5};
-
-
-	powers = {
-		{X1, 0}
-		, {Y1, 0}
-		, {X2, 0}
-		, {Y2, 0}
-	};
-
-	cntPowers = {
-		{X1, 0}
-		, {Y1, 0}
-		, {X2, 0}
-		, {Y2, 0}
-	};
-
-	indices = {
-		{Qt::Key_D, X1}
-		, {Qt::Key_A, X1}
-		, {Qt::Key_W, Y1}
-		, {Qt::Key_S, Y1}
-		, {Qt::Key_Right, X2}
-		, {Qt::Key_Left, X2}
-		, {Qt::Key_Up, Y2}
-		, {Qt::Key_Down, Y2}
-	};
-	additions = {
-		{Qt::Key_D, 10}
-		, {Qt::Key_A, -10}
-		, {Qt::Key_W, 10}
-		, {Qt::Key_S, -10}
-		, {Qt::Key_Right, 10}
-		, {Qt::Key_Left, -10}
-		, {Qt::Key_Up, 10}
-		, {Qt::Key_Down, -10}
-	};
-
+	connect(&stopTimerForPad1, &QTimer::timeout, this, [this]() { cancelStopTimer(1); stopPads(1); });
+	connect(&stopTimerForPad2, &QTimer::timeout, this, [this]() { cancelStopTimer(2); stopPads(2); });
+	connect(&scheduler, &ControlScheduler::tick, this, &AccelerateStrategy::dealWithPads);
 }
 
 void AccelerateStrategy::processEvent(QEvent *event)
 {
 	int eventType = event->type();
 	if (eventType == QEvent::KeyPress || eventType == QEvent::KeyRelease) {
-		auto keyEvent = dynamic_cast<QKeyEvent *> (event);
-		auto key = static_cast<Qt::Key> (keyEvent->key());
-		QSet<int> allKeys = pad1 + pad2 + magicButtons;
-		if (allKeys.contains(key)) {
-			if (!workTimer.isActive())
-				workTimer.start(speed);
-
-			if (magicButtons.contains(key))
+		auto keyEvent = static_cast<QKeyEvent *> (event);
+		const auto id = ControlKeys::idOf(keyEvent->key());
+		if (id != ControlKeys::none) {
+			if (!scheduler.isActive())
+				scheduler.start();
+
+			if (ControlKeys::bit(id) & ControlKeys::buttonKeys)
 				dealWithButtons(keyEvent);
 			else {
 				if (!keyEvent->isAutoRepeat()) {
 					if (eventType == QEvent::KeyPress)
-						mPressedKeys += key;
+						mPressedMask |= ControlKeys::bit(id);
 					else
-						mPressedKeys -= key;
+						mPressedMask &= static_cast<ControlKeys::Mask>(~ControlKeys::bit(id));
 				}
 			}
 		}
@@ -96,119 +111,227 @@ void AccelerateStrategy::processEvent(QEvent *event)
 	}
 }
 
+void AccelerateStrategy::reset()
+{
+	Strategy::reset();
+	// Otherwise only stop timers release pads, and a strategy deleted before they fire leaves the robot driving
+	if (pad1WasActive) {
+		cancelStopTimer(1);
+		stopPads(1);
+	}
+
+	if (pad2WasActive) {
+		cancelStopTimer(2);
+		stopPads(2);
+	}
+}
+
+void AccelerateStrategy::setVirtualClock(bool enabled)
+{
+	Strategy::setVirtualClock(enabled);
+	scheduler.setVirtualClock(enabled);
+	cancelStopTimer(1);
+	cancelStopTimer(2);
+}
+
+void AccelerateStrategy::advanceClock(qint64 elapsedUs)
+{
+	const qint64 target = mVirtualTime + elapsedUs;
+	for (;;) {
+		// The earliest of the next tick and pad stops, a tick goes first at the same time
+		qint64 next = scheduler.nextTickAt();
+		int pad = 0;
+		for (int i = 0; i < 2; ++i) {
+			if (stopDeadlines[i] >= 0 && (next < 0 || stopDeadlines[i] < next)) {
+				next = stopDeadlines[i];
+				pad = i + 1;
+			}
+		}
+
+		if (next < 0 || next > target) {
+			break;
+		}
+
+		mVirtualTime = next;
+		if (pad) {
+			stopDeadlines[pad - 1] = -1;
+			stopPads(pad);
+		}
+
+		scheduler.advanceTo(next);
+	}
+
+	mVirtualTime = target;
+	scheduler.advanceTo(target);
+}
+
 void AccelerateStrategy::setSpeed(int newSpeed)
 {
 	speed = newSpeed;
 }
 
-void AccelerateStrategy::stopPads(int padNumber)
+void AccelerateStrategy::setCurve(Curve newCurve)
 {
+	curve = newCurve;
+}
 
-	const QString padUp = "pad %1 up\n";
+void AccelerateStrategy::setRampTime(int newRampTime)
+{
+	rampTime = std::max(1, newRampTime);
+}
+
+void AccelerateStrategy::setControlRate(int rate)
+{
+	scheduler.setRate(rate);
+}
+
+void AccelerateStrategy::loadSettings(const QSettings &settings)
+{
+	const auto &curveName = settings.value("accelerationCurve", "linear").toString();
+	if (curveName == "exponential") {
+		setCurve(Curve::exponential);
+	} else if (curveName == "s-curve") {
+		setCurve(Curve::sCurve);
+	} else {
+		setCurve(Curve::linear);
+	}
+
+	setRampTime(settings.value("accelerationRamp", 10 * speed).toInt());
+	setControlRate(settings.value("controlRate", scheduler.rate()).toInt());
+}
+
+void AccelerateStrategy::stopPads(int padNumber)
+{
 	switch (padNumber) {
 	case 1:
-		powers[X1] = powers[Y1] = 0;
-		cntPowers[X1] = cntPowers[X1] = 0;
+		resetPower(X1);
+		resetPower(Y1);
+		// Only X1 idle time is reset here since the very first version, kept so the pad behaves as it always did
+		idleTime[X1] = 0;
 		pad1WasActive = false;
-		Q_EMIT commandPrepared(padUp.arg(1));
+		prepareCommand(GamepadCommand::padUp(1));
 		break;
 	case 2:
-		powers[X2] = powers[Y2] = 0;
-		cntPowers[X2] = cntPowers[Y2] = 0;
+		resetPower(X2);
+		resetPower(Y2);
+		idleTime[X2] = idleTime[Y2] = 0;
 		pad2WasActive = false;
-		Q_EMIT commandPrepared(padUp.arg(2));
+		prepareCommand(GamepadCommand::padUp(2));
 		break;
 	default:
 		break;
 	}
 
+	flushFrame();
+
 	if (!pad1WasActive && !pad2WasActive)
-		workTimer.stop();
+		scheduler.stop();
 }
 
-void AccelerateStrategy::dealWithPads()
+void AccelerateStrategy::dealWithPads(qint64 elapsedUs)
 {
 
-	if (!mPressedKeys.empty()) {
+	if (mPressedMask & padKeys) {
+		const double step = static_cast<double>(elapsedUs) / (rampTime * 1000.0);
 
 		// for pad1
-		bool isSomeKeyFromPad1 = false;
-		for (auto &&pad1Key : qAsConst(pad1)) {
-			if (mPressedKeys.contains(pad1Key)) {
-				stopTimerForPad1.start(2 * speed + 100);
-				isSomeKeyFromPad1 = true;
-				pad1WasActive = true;
-				Power index = indices[pad1Key];
-				powers[index] = std::max(-100, std::min(100, powers[index] + additions[pad1Key]));
-				cntPowers[index] = 0;
-			}
-		}
+		const bool isSomeKeyFromPad1 = acceleratePad(1, ControlKeys::w, ControlKeys::d, step, pad1WasActive);
 		if (pad1WasActive) {
-			checkPower(powers[X1], cntPowers[X1], QSet<Qt::Key> {Qt::Key_A, Qt::Key_D});
-			checkPower(powers[Y1], cntPowers[Y1], QSet<Qt::Key> {Qt::Key_W, Qt::Key_S});
+			checkPower(X1, ControlKeys::bit(ControlKeys::a) | ControlKeys::bit(ControlKeys::d), elapsedUs);
+			checkPower(Y1, ControlKeys::bit(ControlKeys::w) | ControlKeys::bit(ControlKeys::s), elapsedUs);
 		}
 
 		if (isSomeKeyFromPad1) {
-			QString command = QString("pad 1 %1 %2 \n").arg(powers[X1]).arg(powers[Y1]);
-			Q_EMIT commandPrepared(command);
+			prepareCommand(GamepadCommand::pad(1, powers[X1], powers[Y1]));
 		}
 
 		// for pad2
-		bool isSomeKeyFromPad2 = false;
-		for (auto &&pad2Key : qAsConst(pad2)) {
-			if (mPressedKeys.contains(pad2Key)) {
-				stopTimerForPad2.start(2 * speed + 100);
-				isSomeKeyFromPad2 = true;
-				pad2WasActive = true;
-				Power index = indices[pad2Key];
-				powers[index] = std::max(-100, std::min(100, powers[index] + additions[pad2Key]));
-				cntPowers[index] = 0;
-			}
-		}
+		const bool isSomeKeyFromPad2 = acceleratePad(2, ControlKeys::left, ControlKeys::down, step, pad2WasActive);
 		if (pad2WasActive) {
-			checkPower(powers[X2], cntPowers[X2], QSet<Qt::Key> {Qt::Key_Left, Qt::Key_Right});
-			checkPower(powers[Y2], cntPowers[Y2], QSet<Qt::Key> {Qt::Key_Up, Qt::Key_Down});
+			checkPower(X2, ControlKeys::bit(ControlKeys::left) | ControlKeys::bit(ControlKeys::right), elapsedUs);
+			checkPower(Y2, ControlKeys::bit(ControlKeys::up) | ControlKeys::bit(ControlKeys::down), elapsedUs);
 		}
 
 		if (isSomeKeyFromPad2) {
-			QString command = QString("pad 2 %1 %2 \n").arg(powers[X2]).arg(powers[Y2]);
-			Q_EMIT commandPrepared(command);
+			prepareCommand(GamepadCommand::pad(2, powers[X2], powers[Y2]));
 		}
+
+		// Both pads of the tick are sent together
+		flushFrame();
 	}
 }
 
-void AccelerateStrategy::dealWithButtons(QKeyEvent *keyEvent)
+bool AccelerateStrategy::acceleratePad(int padNumber, int first, int last, double step, bool &wasActive)
+{
+	bool isSomeKeyFromPad = false;
+	for (int id = first; id <= last; ++id) {
+		if (mPressedMask & ControlKeys::bit(id)) {
+			startStopTimer(padNumber);
+			isSomeKeyFromPad = true;
+			wasActive = true;
+			const auto &acceleration = keyAccelerations[id];
+			const auto axis = static_cast<size_t>(acceleration.power);
+			auto &axisProgress = progress[axis];
+			axisProgress = std::max(-1.0, std::min(1.0, axisProgress + acceleration.direction * step));
+			const double share = shape(curve, std::abs(axisProgress));
+			powers[axis] = static_cast<int>(std::lround(std::copysign(100.0 * share, axisProgress)));
+			idleTime[axis] = 0;
+		}
+	}
+
+	return isSomeKeyFromPad;
+}
+
+void AccelerateStrategy::startStopTimer(int padNumber)
+{
+	const int timeout = 2 * speed + 100;
+	if (mVirtualClock) {
+		stopDeadlines[padNumber - 1] = mVirtualTime + timeout * 1000LL;
+	} else {
+		(padNumber == 1 ? stopTimerForPad1 : stopTimerForPad2).start(timeout);
+	}
+}
+
+void AccelerateStrategy::cancelStopTimer(int padNumber)
+{
+	stopDeadlines[padNumber - 1] = -1;
+	(padNumber == 1 ? stopTimerForPad1 : stopTimerForPad2).stop();
+}
+
+bool AccelerateStrategy::isTicking() const
 {
-	QMap<int, int> digits = {
-		{Qt::Key_1, 1}
-		, {Qt::Key_2, 2}
-		, {Qt::Key_3, 3}
-		, {Qt::Key_4, 4}
-		, {Qt::Key_5, 5}
-	};
+	return scheduler.isActive();
+}
+
+bool AccelerateStrategy::isStopTimerActive(int padNumber) const
+{
+	return stopDeadlines[padNumber - 1] >= 0 || (padNumber == 1 ? stopTimerForPad1 : stopTimerForPad2).isActive();
+}
 
-	auto key = keyEvent->key();
+void AccelerateStrategy::dealWithButtons(QKeyEvent *keyEvent)
+{
 	if (keyEvent->type() == QEvent::KeyPress) {
-		QString command = QString("btn " + QString::number(digits[key]) + "\n");
-		Q_EMIT commandPrepared(command);
+		prepareCommand(GamepadCommand::button(ControlKeys::idOf(keyEvent->key()) - ControlKeys::digit1 + 1));
+		flushFrame();
 	}
 }
 
-void AccelerateStrategy::checkPower(int &power, int &cnt, QSet<Qt::Key> set)
+void AccelerateStrategy::checkPower(Power power, ControlKeys::Mask keys, qint64 elapsedUs)
 {
-	if (power) {
-		bool contains = false;
-		for (auto key : set) {
-			contains = contains || mPressedKeys.contains(key);
-		}
-		if (!contains) {
-			if (cnt) {
-				cnt = 0;
-				power = 0;
-			} else {
-				cnt++;
+	auto &idle = idleTime[power];
+	if (powers[power]) {
+		if (!(mPressedMask & keys)) {
+			idle += elapsedUs;
+			if (idle > speed * 1000LL) {
+				idle = 0;
+				resetPower(power);
 			}
 		}
 	}
 }
 
+void AccelerateStrategy::resetPower(Power power)
+{
+	powers[power] = 0;
+	progress[power] = 0.0;
+}
@@ -18,64 +18,119 @@
 #pragma once
 
 #include "strategy.h"
+#include "controlScheduler.h"
 
+#include <QtCore/QSettings>
 #include <QtCore/QTimer>
-#include <QtCore/QSignalMapper>
 
-/// class that generates commands from pad with various values depending on time a key is pressed
+#include <array>
+
+/// class that generates commands from pad with various values depending on time a key is pressed.
+/// State is kept in small arrays indexed by axis or by ControlKeys id, so a tick builds no containers.
+/// Power grows with the time a key is held, measured by ControlScheduler, along the selected curve,
+/// so acceleration does not depend on control rate or on how late timer events come.
 class AccelerateStrategy : public Strategy
 {
 	Q_OBJECT
 	Q_DISABLE_COPY(AccelerateStrategy)
 
 public:
+	/// Shape of power growth, power is 100 * f(t / rampTime) for key held for time t
+	enum class Curve {
+		linear
+		, exponential ///< slow start for fine positioning, fast finish
+		, sCurve ///< smooth start and smooth approach to full power
+	};
+
 	/// set initial period of time to check dealWithPads
 	explicit AccelerateStrategy(int speed, QObject *parent = nullptr);
 	/// slot for getting events from UI
 	void processEvent(QEvent *event) final;
-	/// set period of time to check dealWithPads
+	/// releases all keys and stops active pads right away instead of waiting for their stop timers
+	void reset() override;
+	/// on virtual clock stop timers become deadlines and control ticks come from ControlScheduler::advanceTo()
+	void setVirtualClock(bool enabled) override;
+	/// fires control ticks and pad stops due by new time one by one in time order, as timers would
+	void advanceClock(qint64 elapsedUs) override;
+	/// set period of time after which a released axis falls to zero
 	void setSpeed(int newSpeed);
 
-private slots:
+	/// sets shape of power growth
+	void setCurve(Curve curve);
+	/// sets time in ms for a held key to reach full power
+	void setRampTime(int rampTime);
+	/// sets number of pad updates per second, up to ControlScheduler::maxRate
+	void setControlRate(int rate);
+
+	/// applies accelerationCurve (linear, exponential, s-curve), accelerationRamp and controlRate settings
+	void loadSettings(const QSettings &settings);
+
+protected slots:
 	/// slot for stopping pads if they were active
 	void stopPads(int padNumber);
 
-	/// slot that analyzes mPressedKeys and generates pad-commands
-	/// pads values are changed iteratively every period of time
-	void dealWithPads();
+	/// slot that analyzes pressed keys and generates pad-commands
+	/// pads values are changed by time elapsed since the previous tick, in microseconds
+	void dealWithPads(qint64 elapsedUs);
+
+protected:
+	// Timers can be driven by hand through these, so benchmarks run the strategy without event loop
 
+	/// true while control ticks are running
+	bool isTicking() const;
+	/// true if timer releasing the pad is running
+	bool isStopTimerActive(int padNumber) const;
+	void cancelStopTimer(int padNumber);
+
+private slots:
 	/// slot for Magic Buttons
 	void dealWithButtons(QKeyEvent *keyEvent);
 
 private:
-
 	enum Power {
 		X1 = 0
 		, Y1
 		, X2
 		, Y2
+		, powerCount
 	};
 
-	/// checks if some key from set was pressed no longer than 1 tact
-	void checkPower(int &power, int &cnt, QSet<Qt::Key> set);
-	QMap<Power, int> powers;
-	QMap<int, Power> indices;
-	QMap<int, int> additions;
+	/// accelerates pad by pressed keys with ids from first to last, returns true if some of them is pressed
+	bool acceleratePad(int padNumber, int first, int last, double step, bool &wasActive);
+
+	/// (re)starts timer releasing the pad, on the virtual clock if it is used
+	void startStopTimer(int padNumber);
+
+	/// sets axis to zero if no key from set was pressed for longer than speed
+	void checkPower(Power power, ControlKeys::Mask keys, qint64 elapsedUs);
+
+	/// sets axis to zero
+	void resetPower(Power power);
+
+	/// sent power of an axis, shaped by the curve from progress
+	std::array<int, powerCount> powers {};
 
-	/// variables for setting 0 to PowerVariables if they were not pressed more than 1 tact
-	QMap<Power, int> cntPowers;
+	/// signed share of ramp time the axis was driven for, from -1 to 1
+	std::array<double, powerCount> progress {};
 
+	/// time in microseconds since a key of the axis was released, for setting 0 to power after speed ms
+	std::array<qint64, powerCount> idleTime {};
+
+	/// Timers are children, so they follow the strategy to control thread
 	QTimer stopTimerForPad1;
 	QTimer stopTimerForPad2;
+	/// virtual time in microseconds pads are stopped at on virtual clock, -1 if not scheduled
+	std::array<qint64, 2> stopDeadlines {{-1, -1}};
 	bool pad1WasActive { false };
 	bool pad2WasActive { false };
 
-	QSet<int> pad1;
-	QSet<int> pad2;
-	QSet<int> magicButtons;
-	QTimer workTimer;
+	ControlScheduler scheduler;
 
-	/// defines period of time to check dealWithPads
+	/// defines period of time after which a released axis falls to zero
 	int speed;
-};
 
+	/// time in ms for a held key to reach full power
+	int rampTime;
+
+	Curve curve { Curve::linear };
+};
@@ -0,0 +1,266 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "commandCodec.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+/// Appends decimal representation of a number without creating temporary strings
+void appendNumber(QByteArray &buffer, int number)
+{
+	char digits[12];
+	int position = sizeof(digits);
+	const bool negative = number < 0;
+	unsigned int absolute = negative ? 0u - static_cast<unsigned int>(number) : static_cast<unsigned int>(number);
+	do {
+		digits[--position] = static_cast<char>('0' + absolute % 10);
+		absolute /= 10;
+	} while (absolute != 0);
+
+	if (negative) {
+		digits[--position] = '-';
+	}
+
+	buffer.append(digits + position, static_cast<int>(sizeof(digits)) - position);
+}
+
+/// Length byte of binary frame for given command type, 0 for commands that can not be encoded
+int frameLength(GamepadCommand::Type type)
+{
+	// Type and sequence number are followed by payload
+	constexpr int header = 3;
+	switch (type) {
+	case GamepadCommand::Type::pad:
+		return header + 3;
+	case GamepadCommand::Type::padUp:
+	case GamepadCommand::Type::button:
+		return header + 1;
+	case GamepadCommand::Type::keepalive:
+	case GamepadCommand::Type::protocol:
+	case GamepadCommand::Type::ping:
+	case GamepadCommand::Type::echo:
+		return header + 2;
+	default:
+		return 0;
+	}
+}
+
+}
+
+CommandCodec::CommandCodec(Protocol protocol)
+	: mProtocol(protocol)
+{
+}
+
+CommandCodec::Protocol CommandCodec::protocol() const
+{
+	return mProtocol;
+}
+
+void CommandCodec::setProtocol(Protocol protocol)
+{
+	mProtocol = protocol;
+}
+
+void CommandCodec::encode(const GamepadCommand &command, QByteArray &buffer) const
+{
+	// Negotiation is always done in text, robot does not know yet that we can speak binary
+	if (mProtocol == Protocol::binary && command.type != GamepadCommand::Type::protocol) {
+		encodeBinary(command, buffer);
+	} else {
+		encodeText(command, buffer);
+	}
+}
+
+quint16 CommandCodec::nextSequence()
+{
+	static std::atomic<quint16> sequence { 0 };
+	return sequence++;
+}
+
+int CommandCodec::decode(const char *data, int size, GamepadCommand &command)
+{
+	if (size <= 0) {
+		return 0;
+	}
+
+	const auto first = static_cast<unsigned char>(data[0]);
+	return first >= 1 && first <= maxFrameLength
+			? decodeBinary(data, size, command)
+			: decodeText(data, size, command);
+}
+
+void CommandCodec::encodeText(const GamepadCommand &command, QByteArray &buffer) const
+{
+	switch (command.type) {
+	case GamepadCommand::Type::pad:
+		buffer.append("pad ");
+		appendNumber(buffer, command.id);
+		buffer.append(' ');
+		appendNumber(buffer, command.x);
+		buffer.append(' ');
+		appendNumber(buffer, command.y);
+		buffer.append(" \n");
+		break;
+	case GamepadCommand::Type::padUp:
+		buffer.append("pad ");
+		appendNumber(buffer, command.id);
+		buffer.append(" up\n");
+		break;
+	case GamepadCommand::Type::button:
+		buffer.append("btn ");
+		appendNumber(buffer, command.id);
+		buffer.append('\n');
+		break;
+	case GamepadCommand::Type::keepalive:
+		buffer.append("keepalive ");
+		appendNumber(buffer, command.value);
+		buffer.append('\n');
+		break;
+	case GamepadCommand::Type::protocol:
+		buffer.append("protocol ");
+		appendNumber(buffer, command.value);
+		buffer.append('\n');
+		break;
+	case GamepadCommand::Type::ping:
+		buffer.append("ping ");
+		appendNumber(buffer, command.value);
+		buffer.append('\n');
+		break;
+	case GamepadCommand::Type::echo:
+		buffer.append("echo ");
+		appendNumber(buffer, command.value);
+		buffer.append('\n');
+		break;
+	default:
+		break;
+	}
+}
+
+void CommandCodec::encodeBinary(const GamepadCommand &command, QByteArray &buffer) const
+{
+	const int length = frameLength(command.type);
+	if (length == 0) {
+		return;
+	}
+
+	char frame[maxFrameLength + 1];
+	frame[0] = static_cast<char>(length);
+	frame[1] = static_cast<char>(command.type);
+	frame[2] = static_cast<char>(command.sequence >> 8);
+	frame[3] = static_cast<char>(command.sequence & 0xff);
+	switch (command.type) {
+	case GamepadCommand::Type::pad:
+		frame[4] = static_cast<char>(command.id);
+		frame[5] = static_cast<char>(command.x);
+		frame[6] = static_cast<char>(command.y);
+		break;
+	case GamepadCommand::Type::padUp:
+	case GamepadCommand::Type::button:
+		frame[4] = static_cast<char>(command.id);
+		break;
+	default:
+		frame[4] = static_cast<char>(command.value >> 8);
+		frame[5] = static_cast<char>(command.value & 0xff);
+		break;
+	}
+
+	buffer.append(frame, length + 1);
+}
+
+int CommandCodec::decodeText(const char *data, int size, GamepadCommand &command)
+{
+	const int window = qMin(size, maxLineLength);
+	const auto end = static_cast<const char *>(std::memchr(data, '\n', static_cast<size_t>(window)));
+	if (!end) {
+		// Line that can not be a command, the rest of it is dropped the same way up to the next newline
+		command = GamepadCommand();
+		return size < maxLineLength ? 0 : maxLineLength;
+	}
+
+	const int consumed = static_cast<int>(end - data) + 1;
+	command = GamepadCommand();
+	const auto parts = QByteArray::fromRawData(data, consumed - 1).simplified().split(' ');
+	if (parts.size() < 2) {
+		return consumed;
+	}
+
+	bool ok = false;
+	const int id = parts[1].toInt(&ok);
+	if (!ok) {
+		return consumed;
+	}
+
+	const auto &name = parts[0];
+	if (name == "pad" && parts.size() == 3 && parts[2] == "up") {
+		command = GamepadCommand::padUp(id);
+	} else if (name == "pad" && parts.size() == 4) {
+		bool xOk = false;
+		bool yOk = false;
+		const int x = parts[2].toInt(&xOk);
+		const int y = parts[3].toInt(&yOk);
+		if (xOk && yOk) {
+			command = GamepadCommand::pad(id, qBound(-100, x, 100), qBound(-100, y, 100));
+		}
+	} else if (name == "btn" && parts.size() == 2) {
+		command = GamepadCommand::button(id);
+	} else if (name == "keepalive" && parts.size() == 2) {
+		command = GamepadCommand::keepalive(id);
+	} else if (name == "protocol" && parts.size() == 2) {
+		command = GamepadCommand::protocol(id);
+	} else if (name == "ping" && parts.size() == 2) {
+		command = GamepadCommand::ping(id);
+	} else if (name == "echo" && parts.size() == 2) {
+		command = GamepadCommand::echo(id);
+	}
+
+	return consumed;
+}
+
+int CommandCodec::decodeBinary(const char *data, int size, GamepadCommand &command)
+{
+	const int length = static_cast<unsigned char>(data[0]);
+	if (size < length + 1) {
+		return 0;
+	}
+
+	command = GamepadCommand();
+	const auto type = static_cast<GamepadCommand::Type>(static_cast<unsigned char>(data[1]));
+	if (length < 3 || frameLength(type) != length) {
+		return length + 1;
+	}
+
+	const auto byte = [data](int index) { return static_cast<unsigned char>(data[index]); };
+	command.type = type;
+	command.sequence = static_cast<quint16>(byte(2) << 8 | byte(3));
+	switch (type) {
+	case GamepadCommand::Type::pad:
+		command.id = byte(4);
+		command.x = static_cast<qint8>(data[5]);
+		command.y = static_cast<qint8>(data[6]);
+		break;
+	case GamepadCommand::Type::padUp:
+	case GamepadCommand::Type::button:
+		command.id = byte(4);
+		break;
+	default:
+		command.value = static_cast<quint16>(byte(4) << 8 | byte(5));
+		break;
+	}
+
+	return length + 1;
+}
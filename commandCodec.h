@@ -0,0 +1,76 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+
+#include "gamepadCommand.h"
+
+/// Converts gamepad commands to bytes on the wire and back.
+/// Two protocols are supported:
+/// * text --- "pad 1 0 -100 \n" and friends, understood by every TRIK robot;
+/// * binary --- length-prefixed frames, enabled only when the robot acknowledges "protocol 1" command.
+/// Binary frame is: <length> <type> <sequence high byte> <sequence low byte> <payload>, where length counts
+/// bytes after itself and never exceeds maxFrameLength, so the first byte of a frame can not be confused with
+/// the first letter of a text command. Decoder accepts both protocols in the same stream.
+class CommandCodec
+{
+public:
+	/// Wire protocol used by encoder
+	enum class Protocol {
+		text
+		, binary
+	};
+
+	/// Version of binary protocol, sent in "protocol" command during negotiation
+	static constexpr int binaryProtocolVersion = 1;
+
+	/// Maximal value of the length byte of binary frame
+	static constexpr int maxFrameLength = 8;
+
+	/// Maximal length of text command with its newline. Longer lines are garbage, decoder drops them in pieces of
+	/// this size instead of waiting for a newline, so input buffers stay bounded.
+	static constexpr int maxLineLength = 64;
+
+	/// Creates codec which encodes commands using given protocol
+	explicit CommandCodec(Protocol protocol = Protocol::text);
+
+	/// Returns protocol used by encoder
+	Protocol protocol() const;
+
+	/// Switches encoder to given protocol
+	void setProtocol(Protocol protocol);
+
+	/// Appends encoded command to the end of buffer
+	void encode(const GamepadCommand &command, QByteArray &buffer) const;
+
+	/// Returns next sequence number for outgoing commands. Numbers are shared by all connections, so every robot
+	/// sees them increasing no matter whether commands are encoded once for many robots or by its own connection.
+	static quint16 nextSequence();
+
+	/// Decodes one command from the beginning of data. Returns number of consumed bytes or 0 if data does not
+	/// contain a complete command yet. Malformed commands are consumed and reported as Type::invalid, so are
+	/// maxLineLength bytes of text without a newline.
+	static int decode(const char *data, int size, GamepadCommand &command);
+
+private:
+	void encodeText(const GamepadCommand &command, QByteArray &buffer) const;
+	void encodeBinary(const GamepadCommand &command, QByteArray &buffer) const;
+
+	static int decodeText(const char *data, int size, GamepadCommand &command);
+	static int decodeBinary(const char *data, int size, GamepadCommand &command);
+
+	Protocol mProtocol;
+};
@@ -0,0 +1,90 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <array>
+
+#include "gamepadCommand.h"
+
+/// Commands produced during one control tick. They are sent to the robot with a single socket write, so both pads
+/// change at the same moment. Storage is fixed, so filling and copying a frame never allocates.
+class CommandFrame
+{
+public:
+	/// Maximal number of commands in a frame: two pads, five magic buttons and some room for service commands
+	static constexpr int capacity = 16;
+
+	/// Creates empty frame
+	CommandFrame() = default;
+
+	/// Creates frame with a single command
+	explicit CommandFrame(const GamepadCommand &command)
+	{
+		append(command);
+	}
+
+	/// Appends command to the frame, returns false if the frame is full
+	bool append(const GamepadCommand &command)
+	{
+		if (mSize == capacity) {
+			return false;
+		}
+
+		mCommands[static_cast<size_t>(mSize++)] = command;
+		return true;
+	}
+
+	/// Removes all commands
+	void clear()
+	{
+		mSize = 0;
+	}
+
+	/// Number of commands in the frame
+	int size() const
+	{
+		return mSize;
+	}
+
+	/// Returns true if there are no commands in the frame
+	bool isEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	/// Command with given index
+	const GamepadCommand &at(int index) const
+	{
+		return mCommands[static_cast<size_t>(index)];
+	}
+
+	/// Iterator to the first command
+	const GamepadCommand *begin() const
+	{
+		return mCommands.data();
+	}
+
+	/// Iterator past the last command
+	const GamepadCommand *end() const
+	{
+		return mCommands.data() + mSize;
+	}
+
+private:
+	std::array<GamepadCommand, capacity> mCommands;
+	int mSize {};
+};
+
+Q_DECLARE_METATYPE(CommandFrame)
@@ -24,10 +24,12 @@
 
 ConnectForm::ConnectForm(ConnectionManager *manager
 						 , QSettings *settings
-						 , QWidget *parent)
+						 , QWidget *parent
+						 , const QString &settingsPrefix)
 	: QDialog(parent)
 	, mUi(new Ui::ConnectForm)
 	, mSettings(settings)
+	, mSettingsPrefix(settingsPrefix)
 	, connectionManager(manager)
 {
 	mUi->setupUi(this);
@@ -43,10 +45,13 @@ ConnectForm::ConnectForm(ConnectionManager *manager
 	mUi->connectButton->setText(connectButton);
 	mUi->advancedButton->setText(advancedButton);
 
-	mUi->robotIpLineEdit->setText(settings->value("gamepadIp", "192.168.77.1").toString());
-	mUi->robotPortLineEdit->setText(settings->value("gamepadPort", "4444").toString());
-	mUi->cameraIPLineEdit->setText(settings->value("cameraIp", "192.168.77.1").toString());
-	mUi->cameraPortLineEdit->setText(settings->value("cameraPort", "8080").toString());
+	mUi->robotIpLineEdit->setText(settings->value(settingsPrefix + "gamepadIp", "192.168.77.1").toString());
+	mUi->robotPortLineEdit->setText(settings->value(settingsPrefix + "gamepadPort", "4444").toString());
+	mUi->cameraIPLineEdit->setText(settings->value(settingsPrefix + "cameraIp", "192.168.77.1").toString());
+	mUi->cameraPortLineEdit->setText(settings->value(settingsPrefix + "cameraPort", "8080").toString());
+	const auto &padTransport = settings->value(settingsPrefix + "padTransport", "tcp").toString();
+	mUi->padTransportComboBox->setCurrentIndex(padTransport == "udp" ? 1 : 0);
+	mUi->binaryProtocolCheckBox->setChecked(settings->value(settingsPrefix + "binaryProtocol", false).toBool());
 
 	// Connecting buttons with methods
 	connect(mUi->cancelButton, &QPushButton::pressed, this, &QDialog::reject);
@@ -66,10 +71,13 @@ void ConnectForm::onConnectButtonClicked()
 	this->reject(); //??? Why `reject`?
 
 
-	mSettings->setValue("cameraIp", cameraIp);
-	mSettings->setValue("cameraPort", cameraPort);
-	mSettings->setValue("gamepadIp", ip);
-	mSettings->setValue("gamepadPort", port);
+	mSettings->setValue(mSettingsPrefix + "cameraIp", cameraIp);
+	mSettings->setValue(mSettingsPrefix + "cameraPort", cameraPort);
+	mSettings->setValue(mSettingsPrefix + "gamepadIp", ip);
+	mSettings->setValue(mSettingsPrefix + "gamepadPort", port);
+	const auto padTransport = mUi->padTransportComboBox->currentIndex() == 1 ? "udp" : "tcp";
+	mSettings->setValue(mSettingsPrefix + "padTransport", padTransport);
+	mSettings->setValue(mSettingsPrefix + "binaryProtocol", mUi->binaryProtocolCheckBox->isChecked());
 
 	Q_EMIT newConnectionParameters();
 }
@@ -94,4 +102,7 @@ void ConnectForm::setVisibilityToAdditionalButtons(bool mode)
 	mUi->cameraPortLineEdit->setVisible(mode);
 	mUi->robotPortLabel->setVisible(mode);
 	mUi->robotPortLineEdit->setVisible(mode);
+	mUi->padTransportLabel->setVisible(mode);
+	mUi->padTransportComboBox->setVisible(mode);
+	mUi->binaryProtocolCheckBox->setVisible(mode);
 }
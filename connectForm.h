@@ -32,9 +32,10 @@ class ConnectForm : public QDialog
 	Q_DISABLE_COPY(ConnectForm)
 
 public:
-	/// Constructor.
+	/// Constructor. Settings keys are prefixed with settingsPrefix, so the same dialog configures any robot
+	/// of a ConnectionPool.
 	ConnectForm(ConnectionManager *connectionManager
-				, QSettings *settings, QWidget *parent = nullptr);
+				, QSettings *settings, QWidget *parent = nullptr, const QString &settingsPrefix = QString());
 
 	/// Constructor that gets the previous entered values or default values
 	ConnectForm(ConnectionManager *manager, QWidget *parent);
@@ -63,6 +64,9 @@ private:
 
 	QSettings *mSettings; /// Does not have ownership
 
+	/// Prefix of settings keys of the robot being configured
+	QString mSettingsPrefix;
+
 	/// ConnectionManager for saving state of internet connection
 	ConnectionManager *connectionManager; /// Does not have ownership
 };
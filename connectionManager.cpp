@@ -15,14 +15,21 @@
  * This file was modified by Konstantin Batoev to make it comply with the requirements of trikRuntime
  * project. See git revision history for detailed changes. */
 
-#include <QEventLoop>
 #include <QNetworkProxy>
+#include <QRandomGenerator>
 #include "connectionManager.h"
 
-ConnectionManager::ConnectionManager(QSettings *settings, QObject *parent)
+ConnectionManager::ConnectionManager(QSettings *settings, const QString &settingsPrefix, QObject *parent)
 	: QObject(parent)
 	, mSettings(settings)
+	, mSettingsPrefix(settingsPrefix)
 {
+	constexpr auto outBufferCapacity = CommandFrame::capacity * 16;
+	mOutBuffer.reserve(outBufferCapacity);
+	mDatagramBuffer.reserve(outBufferCapacity);
+	mPingBuffer.reserve(CommandCodec::maxFrameLength + 16);
+	constexpr auto defaultCongestionThreshold = 256;
+	mCongestionThreshold = mSettings->value("congestionThreshold", defaultCongestionThreshold).toLongLong();
 }
 
 ConnectionManager::~ConnectionManager()
@@ -33,9 +40,37 @@ ConnectionManager::~ConnectionManager()
 void ConnectionManager::init()
 {
 	mKeepaliveTimer = new QTimer(this);
+	mKeepaliveTimer->setSingleShot(true);
+	mKeepaliveTimer->setInterval(3000);
+	mConnectTimer = new QTimer(this);
+	mConnectTimer->setSingleShot(true);
+	mRetryTimer = new QTimer(this);
+	mRetryTimer->setSingleShot(true);
+	mPingTimer = new QTimer(this);
+	mPingTimer->setSingleShot(true);
+	mDeadPeerTimer = new QTimer(this);
+	mClock.start();
+	mPingSentAt.fill(-1);
 	mSocket = new QTcpSocket(this);
+	mUdpSocket = new QUdpSocket(this);
 	connect(mSocket, &QTcpSocket::stateChanged, this, &ConnectionManager::stateChanged);
-	connect(mKeepaliveTimer, &QTimer::timeout, this, [this]() { write("keepalive 4000\n"); } );
+	connect(mSocket, &QTcpSocket::connected, this, &ConnectionManager::onConnected);
+	connect(mSocket, &QTcpSocket::disconnected, this, &ConnectionManager::onDisconnected);
+#ifdef TRIK_USE_QT6
+	connect(mSocket, &QTcpSocket::errorOccurred, this, &ConnectionManager::onSocketError);
+#else
+	connect(mSocket
+			, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error)
+			, this
+			, &ConnectionManager::onSocketError);
+#endif
+	connect(mConnectTimer, &QTimer::timeout, this, &ConnectionManager::onConnectTimeout);
+	connect(mRetryTimer, &QTimer::timeout, this, &ConnectionManager::startConnecting);
+	connect(mPingTimer, &QTimer::timeout, this, &ConnectionManager::sendPing);
+	connect(mDeadPeerTimer, &QTimer::timeout, this, &ConnectionManager::checkPeer);
+	connect(mSocket, &QTcpSocket::readyRead, this, &ConnectionManager::onReadyRead);
+	connect(mSocket, &QTcpSocket::bytesWritten, this, &ConnectionManager::onBytesWritten);
+	connect(mKeepaliveTimer, &QTimer::timeout, this, &ConnectionManager::sendKeepalive);
 }
 
 bool ConnectionManager::isConnected() const
@@ -43,15 +78,437 @@ bool ConnectionManager::isConnected() const
 	return mSocket->state() == QTcpSocket::ConnectedState;
 }
 
-void ConnectionManager::write(const QString &data)
+void ConnectionManager::write(const GamepadCommand &command)
+{
+	auto stamped = command;
+	stamped.sequence = CommandCodec::nextSequence();
+	writeFrame(CommandFrame(stamped));
+}
+
+void ConnectionManager::writeEncoded(const EncodedFrame &frame)
+{
+	const auto &data = mCodec.protocol() == CommandCodec::Protocol::binary ? frame.binary : frame.text;
+	if (data.isEmpty() || mUseUdp || mState != State::connected || !mQueue.isEmpty() || isCongested()) {
+		writeFrame(frame.frame);
+		return;
+	}
+
+	transmit(data);
+	trackUnsent(frame.frame.begin(), frame.frame.end());
+	Q_EMIT frameWritten(frame.frame.at(0).sequence);
+}
+
+void ConnectionManager::writeFrame(const CommandFrame &frame)
+{
+	if (mState != State::connected && !mWasConnected) {
+		return;
+	}
+
+	// Pad positions over UDP do not wait for TCP, only the newest of them matters anyway
+	const auto reliable = mUseUdp && mState == State::connected ? sendPadsAsDatagram(frame) : frame;
+	if (reliable.isEmpty()) {
+		return;
+	}
+
+	// While the link is congested or being restored new frames wait in the queue,
+	// otherwise they would overtake queued ones
+	if (mState != State::connected || !mQueue.isEmpty() || isCongested()) {
+		const auto dropped = mQueue.dropped();
+		mQueue.enqueue(reliable);
+		Q_EMIT sendQueueDepthChanged(mQueue.size());
+		if (mQueue.dropped() != dropped) {
+			Q_EMIT commandsDropped(mQueue.dropped());
+		}
+
+		return;
+	}
+
+	send(reliable.begin(), reliable.end());
+}
+
+CommandFrame ConnectionManager::sendPadsAsDatagram(const CommandFrame &frame)
+{
+	CommandFrame reliable;
+	mDatagramBuffer.resize(0);
+	for (const auto &command : frame) {
+		if (command.type == GamepadCommand::Type::pad || command.type == GamepadCommand::Type::padUp) {
+			mDatagramCodec.encode(command, mDatagramBuffer);
+		}
+
+		// Release of a pad must not be lost, so it is duplicated over TCP. Its datagram still makes receiver
+		// drop pad positions which were sent before the release but arrived after it.
+		if (command.type != GamepadCommand::Type::pad) {
+			reliable.append(command);
+		}
+	}
+
+	if (!mDatagramBuffer.isEmpty()) {
+		// Lost datagram is not an error, next pad position will come soon
+		mUdpSocket->writeDatagram(mDatagramBuffer, mSocket->peerAddress(), mUdpPort);
+	}
+
+	return reliable;
+}
+
+void ConnectionManager::onBytesWritten(qint64 bytes)
+{
+	mLastProgressAt = now();
+	mWrittenBytes += bytes;
+	int sent = 0;
+	while (sent < mUnsent.size() && mUnsent[sent].writtenAfter <= mWrittenBytes) {
+		++sent;
+	}
+
+	mUnsent.remove(0, sent);
+	flushQueue();
+}
+
+void ConnectionManager::flushQueue()
+{
+	if (mState != State::connected || mQueue.isEmpty() || isCongested()) {
+		return;
+	}
+
+	const auto commands = mQueue.takeAll();
+	Q_EMIT sendQueueDepthChanged(0);
+	send(commands.constData(), commands.constData() + commands.size());
+}
+
+bool ConnectionManager::isCongested() const
+{
+	return mSocket->bytesToWrite() > mCongestionThreshold;
+}
+
+void ConnectionManager::send(const GamepadCommand *begin, const GamepadCommand *end)
 {
-	qint64 result = mSocket->write(data.toLatin1().data());
+	// resize() keeps reserved capacity, so encoding does not allocate in the steady state
+	mOutBuffer.resize(0);
+	for (auto command = begin; command != end; ++command) {
+		mCodec.encode(*command, mOutBuffer);
+	}
+
+	transmit(mOutBuffer);
+	trackUnsent(begin, end);
+	if (begin != end) {
+		Q_EMIT frameWritten(begin->sequence);
+	}
+}
+
+void ConnectionManager::transmit(const QByteArray &data)
+{
+	if (mSocket->bytesToWrite() == 0) {
+		mLastProgressAt = now();
+	}
+
+	qint64 result = mSocket->write(data);
+
+	// Probes ride on command traffic, standalone ones are sent only when the link is idle. Socket buffers both
+	// writes and hands them to the OS together. Probe behind a backlog would measure the backlog, so it waits.
+	if (result >= 0 && mState == State::connected && mProbing && isPingDue() && !isCongested()) {
+		writePing();
+	}
+
 	Q_EMIT dataWasWritten(static_cast<int>(result));
+
+	// Any command resets the robot's watchdog, so explicit keepalive is needed only after a pause
+	if (mState == State::connected) {
+		mKeepaliveTimer->start();
+	}
+}
+
+void ConnectionManager::trackUnsent(const GamepadCommand *begin, const GamepadCommand *end)
+{
+	const auto writtenAfter = mWrittenBytes + mSocket->bytesToWrite();
+	for (auto command = begin; command != end; ++command) {
+		mUnsent.append({*command, writtenAfter});
+	}
+}
+
+void ConnectionManager::onConnected()
+{
+	mConnectTimer->stop();
+	mState = State::connected;
+	mWasConnected = true;
+	mUseUdp = robotSetting("padTransport", "tcp").toString() == "udp";
+	const auto udpPort = robotSetting("gamepadUdpPort", static_cast<uint>(mSocket->peerPort()));
+	mUdpPort = static_cast<quint16>(udpPort.toUInt());
+	mRetryAttempt = 0;
+	if (mDowntime.isValid()) {
+		Q_EMIT reconnected(mDowntime.elapsed());
+		mDowntime.invalidate();
+	}
+
+	// Every robot understands text protocol, binary one is used only after the robot acknowledges it
+	mCodec.setProtocol(CommandCodec::Protocol::text);
+	mProbing = false;
+	Q_EMIT protocolChanged(false);
+	mInBuffer.clear();
+	if (robotSetting("binaryProtocol", false).toBool()) {
+		auto negotiation = GamepadCommand::protocol(CommandCodec::binaryProtocolVersion);
+		negotiation.sequence = CommandCodec::nextSequence();
+		send(&negotiation, &negotiation + 1);
+	}
+
+	mPeerEchoes = false;
+	mRttP99 = 0;
+	mWrittenBytes = 0;
+	mUnsent.clear();
+	mLinkStatistics.clear();
+	mPingSentAt.fill(-1);
+	mPingInterval = mSettings->value("pingInterval", 1000).toInt();
+	mPingTimeout = mSettings->value("pingTimeout", 2 * 1000).toInt();
+	mDeadPeerTimeout = mSettings->value("deadPeerTimeout", 400).toInt();
+	mLastPingAt = now();
+	mLastProgressAt = now();
+	mKeepaliveTimer->start();
+	if (mDeadPeerTimeout > 0) {
+		mDeadPeerTimer->start(qMax(1, mDeadPeerTimeout / 4));
+	}
+
+	flushQueue();
+}
+
+void ConnectionManager::onDisconnected()
+{
+	if (mState != State::connected) {
+		return;
+	}
+
+	mKeepaliveTimer->stop();
+	mPingTimer->stop();
+	mDeadPeerTimer->stop();
+	mDowntime.start();
+	scheduleRetry();
+}
+
+void ConnectionManager::onSocketError(QAbstractSocket::SocketError error)
+{
+	Q_UNUSED(error)
+
+	// Errors of established connection are followed by disconnected() signal
+	if (mState == State::connecting) {
+		mConnectTimer->stop();
+		mSocket->abort();
+		handleFailure();
+	}
+}
+
+void ConnectionManager::onConnectTimeout()
+{
+	if (mState == State::connecting) {
+		mSocket->abort();
+		handleFailure();
+	}
+}
+
+void ConnectionManager::onReadyRead()
+{
+	mInBuffer.append(mSocket->readAll());
+	int position = 0;
+	GamepadCommand reply;
+	while (const int consumed = CommandCodec::decode(mInBuffer.constData() + position
+			, mInBuffer.size() - position, reply)) {
+		position += consumed;
+		handleReply(reply);
+	}
+
+	mInBuffer.remove(0, position);
+}
+
+void ConnectionManager::handleReply(const GamepadCommand &reply)
+{
+	switch (reply.type) {
+	case GamepadCommand::Type::protocol:
+		if (reply.value == CommandCodec::binaryProtocolVersion) {
+			mCodec.setProtocol(CommandCodec::Protocol::binary);
+			Q_EMIT protocolChanged(true);
+
+			// Robots speaking binary protocol answer probes, older ones would take them for garbage
+			mProbing = true;
+			mLastPingAt = now();
+			mPingTimer->start(pingInterval());
+		}
+
+		break;
+	case GamepadCommand::Type::echo: {
+		const auto slot = static_cast<size_t>(reply.value % maxPendingPings);
+		if (mPingSentAt[slot] >= 0 && mPingTokens[slot] == reply.value) {
+			const auto rtt = now() - mPingSentAt[slot];
+			mPingSentAt[slot] = -1;
+			mPeerEchoes = true;
+			mLinkStatistics.addSample(rtt);
+			const auto &quality = mLinkStatistics.quality();
+			mRttP99 = quality.rttP99;
+			Q_EMIT linkQualityChanged(quality);
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void ConnectionManager::sendPing()
+{
+	// Probe is not queued: its round-trip time would include the wait, it is skipped till the link drains instead
+	if (mState != State::connected || !mQueue.isEmpty() || isCongested()) {
+		mPingTimer->start(pingInterval());
+		return;
+	}
+
+	writePing();
+	mKeepaliveTimer->start();
+}
+
+void ConnectionManager::writePing()
+{
+	mPingBuffer.resize(0);
+	const auto &ping = preparePing();
+	mCodec.encode(ping, mPingBuffer);
+	mSocket->write(mPingBuffer);
+	mPingWrittenAfter[static_cast<size_t>(ping.value % maxPendingPings)] = mWrittenBytes + mSocket->bytesToWrite();
+}
+
+void ConnectionManager::sendKeepalive()
+{
+	write(GamepadCommand::keepalive(4000));
+}
+
+GamepadCommand ConnectionManager::preparePing()
+{
+	const auto time = now();
+	const qint64 timeout = mPingTimeout * 1000LL;
+	bool lost = false;
+	for (auto &sentAt : mPingSentAt) {
+		if (sentAt >= 0 && time - sentAt > timeout) {
+			sentAt = -1;
+			if (mPeerEchoes) {
+				mLinkStatistics.addLoss();
+				lost = true;
+			}
+		}
+	}
+
+	if (lost) {
+		Q_EMIT linkQualityChanged(mLinkStatistics.quality());
+	}
+
+	const auto token = mNextPingToken++;
+	const auto slot = static_cast<size_t>(token % maxPendingPings);
+	mPingTokens[slot] = token;
+	mPingSentAt[slot] = time;
+	mLastPingAt = time;
+	mPingTimer->start(pingInterval());
+	auto ping = GamepadCommand::ping(token);
+	ping.sequence = CommandCodec::nextSequence();
+	return ping;
+}
+
+bool ConnectionManager::isPingDue() const
+{
+	return now() - mLastPingAt >= pingInterval() * 1000LL;
+}
+
+int ConnectionManager::pingInterval() const
+{
+	return mPeerEchoes && mDeadPeerTimeout > 0 ? qMax(1, mDeadPeerTimeout / 4) : mPingInterval;
+}
+
+int ConnectionManager::deadPeerTimeout() const
+{
+	return qMax(mDeadPeerTimeout, static_cast<int>(deadPeerRttFactor * mRttP99));
+}
+
+void ConnectionManager::checkPeer()
+{
+	const auto time = now();
+	const qint64 limit = deadPeerTimeout() * 1000LL;
+	bool dead = mSocket->bytesToWrite() > 0 && time - mLastProgressAt > limit;
+	if (mPeerEchoes) {
+		// Probe stuck in socket buffer is not missing, stalled writes are caught above. One late echo may be a hiccup
+		// of the robot or of the probe timer, so several probes must be unanswered, the oldest one for too long.
+		int missing = 0;
+		qint64 oldest = time;
+		for (size_t slot = 0; slot < mPingSentAt.size(); ++slot) {
+			if (mPingSentAt[slot] >= 0 && mPingWrittenAfter[slot] <= mWrittenBytes) {
+				++missing;
+				oldest = qMin(oldest, mPingSentAt[slot]);
+			}
+		}
+
+		dead = dead || (missing >= deadPeerMissedProbes && time - oldest > limit);
+	}
+
+	if (dead) {
+		handlePeerLost();
+	}
+}
+
+void ConnectionManager::handlePeerLost()
+{
+	// State is changed first, so disconnected() caused by abort() is not taken for a regular drop
+	mState = State::waitingForRetry;
+	mKeepaliveTimer->stop();
+	mPingTimer->stop();
+	mDeadPeerTimer->stop();
+	mDowntime.start();
+
+	// Commands which did not leave socket buffer are sent again after reconnection, before the queued ones
+	if (!mUnsent.isEmpty()) {
+		const auto queued = mQueue.takeAll();
+		CommandFrame frame;
+		const auto enqueue = [this, &frame](const GamepadCommand &command) {
+			if (!frame.append(command)) {
+				mQueue.enqueue(frame);
+				frame = CommandFrame(command);
+			}
+		};
+
+		for (const auto &unsent : mUnsent) {
+			enqueue(unsent.command);
+		}
+
+		for (const auto &command : queued) {
+			enqueue(command);
+		}
+
+		mQueue.enqueue(frame);
+		mUnsent.clear();
+		Q_EMIT sendQueueDepthChanged(mQueue.size());
+	}
+
+	mSocket->abort();
+	Q_EMIT peerLost();
+	mRetryAttempt = 0;
+	startConnecting();
+}
+
+QVariant ConnectionManager::robotSetting(const QString &key, const QVariant &defaultValue) const
+{
+	return mSettings->value(mSettingsPrefix + key, defaultValue);
+}
+
+qint64 ConnectionManager::now() const
+{
+	return mClock.nsecsElapsed() / 1000;
 }
 
 void ConnectionManager::reset()
 {
+	mState = State::disconnected;
+	mWasConnected = false;
+	mDowntime.invalidate();
+	mConnectTimer->stop();
+	mRetryTimer->stop();
 	mKeepaliveTimer->stop();
+	mPingTimer->stop();
+	mDeadPeerTimer->stop();
+	if (!mQueue.isEmpty()) {
+		mQueue.clear();
+		Q_EMIT sendQueueDepthChanged(0);
+	}
+
 	mSocket->disconnectFromHost();
 	Q_EMIT dataWasWritten(-1); // simulate disconnect
 }
@@ -59,31 +516,42 @@ void ConnectionManager::reset()
 void ConnectionManager::reconnectToHost()
 {
 	reset();
-	constexpr auto timeout = 3 * 1000;
-	QEventLoop loop;
-	QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
-	connect(mSocket, &QTcpSocket::connected, &loop, &QEventLoop::quit);
-#ifdef TRIK_USE_QT6
-	connect(mSocket
-			, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::errorOccurred)
-			, &loop
-			, [&loop](QAbstractSocket::SocketError) { loop.quit(); });
-#else
-	connect(mSocket
-			, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error)
-			, &loop
-			, [&loop](QAbstractSocket::SocketError) { loop.quit(); });
-#endif
+	mRetryAttempt = 0;
+	startConnecting();
+}
+
+void ConnectionManager::startConnecting()
+{
+	// State is changed first, so disconnected() caused by abort() is not taken for a connection drop
+	mState = State::connecting;
+	mSocket->abort();
 	mSocket->setProxy(QNetworkProxy::NoProxy);
-	const auto &gamepadIp = mSettings->value("gamepadIp").toString();
-	auto gamepadPort = static_cast<quint16>(mSettings->value("gamepadPort").toUInt());
+	const auto &gamepadIp = robotSetting("gamepadIp").toString();
+	auto gamepadPort = static_cast<quint16>(robotSetting("gamepadPort").toUInt());
+	mConnectTimer->start(mSettings->value("connectTimeout", 3 * 1000).toInt());
 	mSocket->connectToHost(gamepadIp, gamepadPort);
-	loop.exec();
+}
 
-	if (mSocket->state() == QTcpSocket::ConnectedState) {
-		mKeepaliveTimer->start(3000);
+void ConnectionManager::handleFailure()
+{
+	if (mWasConnected) {
+		scheduleRetry();
 	} else {
-		mSocket->abort();
+		mState = State::disconnected;
 		Q_EMIT connectionFailed();
 	}
 }
+
+void ConnectionManager::scheduleRetry()
+{
+	const int initialDelay = mSettings->value("reconnectInitialDelay", 250).toInt();
+	const int maxDelay = mSettings->value("reconnectMaxDelay", 5 * 1000).toInt();
+	// Exponential backoff, doubling stops at 2^10 to avoid overflow
+	const int backoff = qMin(maxDelay, initialDelay << qMin(mRetryAttempt, 10));
+	// Randomize the second half of the delay, so several gamepads do not hammer the robot in sync
+	const int delay = backoff / 2 + QRandomGenerator::global()->bounded(backoff / 2 + 1);
+	++mRetryAttempt;
+	mState = State::waitingForRetry;
+	mRetryTimer->start(delay);
+	Q_EMIT reconnecting(mRetryAttempt, delay);
+}
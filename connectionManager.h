@@ -19,11 +19,18 @@
 #pragma once
 
 #include <QtNetwork/QTcpSocket>
+#include <QtNetwork/QUdpSocket>
 #include <QtCore/QIODevice>
 #include <QScopedPointer>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QSettings>
 
+#include "commandCodec.h"
+#include "commandFrame.h"
+#include "sendQueue.h"
+#include "linkStatistics.h"
+#include "encodedFrame.h"
 
 /// TODO description
 class ConnectionManager : public QObject
@@ -32,8 +39,10 @@ class ConnectionManager : public QObject
 	Q_DISABLE_COPY(ConnectionManager)
 
 public:
-	/// Create new ConnectionManager for given settings
-	explicit ConnectionManager(QSettings *settings, QObject *parent = nullptr);
+	/// Create new ConnectionManager for given settings. Connection parameters are read from keys starting
+	/// with settingsPrefix, so several robots can be described in the same settings.
+	explicit ConnectionManager(QSettings *settings, const QString &settingsPrefix = QString()
+			, QObject *parent = nullptr);
 	~ConnectionManager();
 
 	/// inits manager after moved to correct thread
@@ -49,10 +58,19 @@ public:
 	bool isConnected() const;
 
 public slots:
-	/// Reinstantiate the connection to the desired host
+	/// Reinstantiate the connection to the desired host. Does not block: result is reported by stateChanged
+	/// or connectionFailed signals. Once connected, dropped connection is re-established automatically.
 	void reconnectToHost();
-	/// TODO description
-	void write(const QString &);
+	/// Encodes command with the protocol negotiated with the robot and sends it
+	void write(const GamepadCommand &command);
+
+	/// Encodes all commands of the frame into one buffer and sends it with a single socket write.
+	/// Commands are expected to have sequence numbers from CommandCodec::nextSequence() already.
+	void writeFrame(const CommandFrame &frame);
+
+	/// Sends frame already encoded for several robots, falls back to writeFrame when the frame can not be sent
+	/// as is: the link is congested or reconnecting, pads go over UDP or the needed protocol was not encoded.
+	void writeEncoded(const EncodedFrame &frame);
 
 	/// Disconnect
 	void reset();
@@ -64,9 +82,226 @@ signals:
 	void dataWasWritten(int);
 	/// TODO description
 	void connectionFailed();
+	/// Emitted when number of commands waiting for congested link changes
+	void sendQueueDepthChanged(int depth);
+	/// Emitted when queued pad positions are replaced by newer ones or commands do not fit into the queue,
+	/// with total number of dropped commands
+	void commandsDropped(int total);
+	/// Emitted when next attempt to restore dropped connection is scheduled after given delay in ms
+	void reconnecting(int attempt, int delay);
+	/// Emitted when dropped connection is restored, with time passed since the drop in ms
+	void reconnected(qint64 downtime);
+	/// Emitted when a latency probe is answered or lost. Only robots which negotiated binary protocol are probed,
+	/// those which do not answer pings produce no updates.
+	void linkQualityChanged(const LinkQuality &quality);
+	/// Emitted when the robot stops answering probes or reading data, right before reconnection starts
+	void peerLost();
+	/// Emitted when wire protocol is switched after connection or negotiation
+	void protocolChanged(bool binary);
+	/// Emitted right after commands are handed to TCP socket, with sequence number of the first of them.
+	/// Used for latency tracing, connect it directly to get the time of the write.
+	void frameWritten(quint16 sequence);
+
+private slots:
+	/// Starts protocol negotiation and sends commands queued while there was no connection
+	void onConnected();
+
+	/// Schedules reconnection if established connection is lost
+	void onDisconnected();
+
+	/// Handles failed connection attempt
+	void onSocketError(QAbstractSocket::SocketError error);
+
+	/// Aborts connection attempt which takes too long
+	void onConnectTimeout();
+
+	/// Handles replies from the robot
+	void onReadyRead();
+
+	/// Sends queued commands when the link drains
+	void onBytesWritten(qint64 bytes);
+
+	/// Sends a probe when there is no command traffic to carry it
+	void sendPing();
+
+	/// Sends keepalive when there is no command traffic to keep the robot's watchdog happy
+	void sendKeepalive();
+
+	/// Checks whether the robot still answers probes and reads data
+	void checkPeer();
 
 private:
+	/// State of the connection to the robot
+	enum class State {
+		disconnected
+		, connecting
+		, connected
+		, waitingForRetry
+	};
+
+	/// Starts asynchronous connection attempt
+	void startConnecting();
+
+	/// Retries with backoff if the connection was established before, reports failure otherwise
+	void handleFailure();
+
+	/// Starts retry timer with exponentially growing and randomized delay
+	void scheduleRetry();
+
+	/// Sends queued commands if the link allows
+	void flushQueue();
+
+	/// Handles command received from the robot
+	void handleReply(const GamepadCommand &reply);
+
+	/// Accounts unanswered probes and creates a new one, stamped with the current time
+	GamepadCommand preparePing();
+
+	/// Hands a new probe to the socket right after it is stamped
+	void writePing();
+
+	/// Returns true if it is time to send next probe
+	bool isPingDue() const;
+
+	/// Interval between probes: short while the robot answers them, so its death is noticed fast
+	int pingInterval() const;
+
+	/// Time without answers or write progress after which the robot is considered dead, in ms. It is the configured
+	/// timeout, stretched on links whose round-trip time is long anyway.
+	int deadPeerTimeout() const;
+
+	/// Drops dead connection and starts reconnecting immediately, commands stuck in socket buffer are queued again
+	void handlePeerLost();
+
+	/// Microseconds since the manager was initialized
+	qint64 now() const;
+
+	/// Number of probes that may be in flight simultaneously
+	static constexpr int maxPendingPings = 64;
+
+	/// Robot is dead only if it does not answer probes for this many p99 round-trip times
+	static constexpr int deadPeerRttFactor = 4;
+
+	/// Number of probes that must be unanswered, the oldest of them for deadPeerTimeout(), to consider the robot dead
+	static constexpr int deadPeerMissedProbes = 3;
+
+	/// Command handed to the socket, with the number of written bytes after which it has left socket buffer
+	struct UnsentCommand
+	{
+		GamepadCommand command;
+		qint64 writtenAfter;
+	};
+
+	/// Returns true if socket buffer holds more unsent data than allowed
+	bool isCongested() const;
+
+	/// Encodes commands into the output buffer and sends it with a single socket write
+	void send(const GamepadCommand *begin, const GamepadCommand *end);
+
+	/// Hands encoded data to the socket together with a probe if it is due
+	void transmit(const QByteArray &data);
+
+	/// Remembers commands just handed to the socket until it writes them to the OS
+	void trackUnsent(const GamepadCommand *begin, const GamepadCommand *end);
+
+	/// Reads connection parameter of this robot
+	QVariant robotSetting(const QString &key, const QVariant &defaultValue = QVariant()) const;
+
+	/// Sends pad commands of the frame in one datagram, returns the rest of the frame which goes over TCP
+	CommandFrame sendPadsAsDatagram(const CommandFrame &frame);
+
 	QTcpSocket *mSocket {};
+	QUdpSocket *mUdpSocket {};
 	QTimer *mKeepaliveTimer {};
+	QTimer *mConnectTimer {};
+	QTimer *mRetryTimer {};
+	QTimer *mPingTimer {};
+	QTimer *mDeadPeerTimer {};
 	QSettings *mSettings; // No ownership
+	QString mSettingsPrefix;
+
+	/// Encoder for outgoing commands, switched to binary protocol when the robot acknowledges it
+	CommandCodec mCodec;
+
+	/// Buffer for encoded frame, reused between writes to avoid allocations
+	QByteArray mOutBuffer;
+
+	/// Buffer for probes riding on command traffic
+	QByteArray mPingBuffer;
+
+	/// Encoder for pad datagrams. They always use binary protocol, since receiver needs sequence numbers
+	/// to drop reordered and stale datagrams.
+	CommandCodec mDatagramCodec { CommandCodec::Protocol::binary };
+
+	/// Buffer for encoded datagram
+	QByteArray mDatagramBuffer;
+
+	/// True if pad positions are sent over UDP
+	bool mUseUdp {};
+
+	/// Port of the robot which receives pad datagrams
+	quint16 mUdpPort {};
+
+	/// Received bytes which do not form a complete reply yet
+	QByteArray mInBuffer;
+
+	/// Commands waiting while the link is congested
+	SendQueue mQueue;
+
+	/// Amount of unsent bytes in socket buffer when the link is considered congested
+	qint64 mCongestionThreshold {};
+
+	State mState { State::disconnected };
+
+	/// True if connection to current host was established, so it shall be restored after drops
+	bool mWasConnected {};
+
+	/// Number of reconnection attempts since the connection was lost
+	int mRetryAttempt {};
+
+	/// Measures time since the connection was lost
+	QElapsedTimer mDowntime;
+
+	/// Monotonic clock for latency measurements
+	QElapsedTimer mClock;
+
+	/// Send time in microseconds of probes in flight, indexed by token modulo maxPendingPings, -1 for free slots
+	std::array<qint64, maxPendingPings> mPingSentAt;
+	std::array<quint16, maxPendingPings> mPingTokens {};
+	quint16 mNextPingToken {};
+
+	/// Number of written bytes after which probe in the slot has left socket buffer
+	std::array<qint64, maxPendingPings> mPingWrittenAfter {};
+
+	/// True if the robot has negotiated binary protocol, so it is probed. Probes are not a part of text protocol.
+	bool mProbing {};
+
+	/// True if the robot has answered at least one probe, so unanswered ones can be counted as lost
+	bool mPeerEchoes {};
+
+	/// 99th percentile of round-trip time, in ms
+	double mRttP99 {};
+
+	/// Bytes the socket has written to the OS since connection
+	qint64 mWrittenBytes {};
+
+	/// Commands handed to the socket but not written to the OS yet, oldest first
+	QVector<UnsentCommand> mUnsent;
+
+	/// Time of the last probe, in microseconds
+	qint64 mLastPingAt {};
+
+	/// Time when the socket last managed to hand data to the OS, in microseconds
+	qint64 mLastProgressAt {};
+
+	/// Probe interval for robots which do not answer probes, in ms
+	int mPingInterval {};
+
+	/// Time after which unanswered probe is considered lost, in ms
+	int mPingTimeout {};
+
+	/// Configured time without answers or write progress after which the robot is considered dead, in ms
+	int mDeadPeerTimeout {};
+
+	LinkStatistics mLinkStatistics;
 };
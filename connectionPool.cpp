@@ -0,0 +1,185 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "connectionPool.h"
+
+ConnectionPool::ConnectionPool(QSettings *settings, QObject *parent)
+	: QObject(parent)
+	, mSettings(settings)
+{
+	// Types crossing the boundary of network thread
+	qRegisterMetaType<QAbstractSocket::SocketState>();
+	qRegisterMetaType<GamepadCommand>();
+	qRegisterMetaType<CommandFrame>();
+	qRegisterMetaType<LinkQuality>();
+	qRegisterMetaType<EncodedFrame>();
+	createRobot(0);
+
+	// Robots added in previous runs, every one of them has an address
+	for (int index = 1; index < maxRobots; ++index) {
+		if (mSettings->contains(settingsPrefix(index) + "gamepadIp")) {
+			createRobot(index);
+		}
+	}
+
+	mThread.start();
+}
+
+ConnectionPool::~ConnectionPool()
+{
+	mThread.quit();
+	mThread.wait();
+}
+
+int ConnectionPool::addRobot()
+{
+	const int index = freeIndex();
+	if (index >= 0) {
+		createRobot(index);
+	}
+
+	return index;
+}
+
+int ConnectionPool::freeIndex() const
+{
+	const int hole = mManagers.indexOf(nullptr);
+	const int index = hole >= 0 ? hole : mManagers.size();
+	return index < maxRobots ? index : -1;
+}
+
+void ConnectionPool::removeRobot(int index)
+{
+	auto manager = mManagers.value(index);
+	if (index == 0 || !manager) {
+		return;
+	}
+
+	setSelected(index, false);
+	mBinaryRobots &= ~(1u << index);
+	mManagers[index] = nullptr;
+
+	// Destructor disconnects the robot in network thread, connections to the manager go away with it
+	manager->deleteLater();
+	mSettings->remove(settingsPrefix(index).chopped(1));
+}
+
+void ConnectionPool::createRobot(int index)
+{
+	if (index >= mManagers.size()) {
+		mManagers.resize(index + 1);
+	}
+
+	auto manager = new ConnectionManager(mSettings, settingsPrefix(index));
+	manager->moveToThread(&mThread);
+	mManagers[index] = manager;
+	mSelected |= 1u << index;
+	mBinaryRobots &= ~(1u << index);
+
+	connect(&mThread, &QThread::finished, manager, &ConnectionManager::deleteLater);
+	connect(this, &ConnectionPool::encodedFrameReady, manager, [manager, index](const EncodedFrame &frame
+			, quint32 robots) {
+		if (robots & (1u << index)) {
+			manager->writeEncoded(frame);
+		}
+	});
+	// Reports are queued, so the ones sent by a removed robot may come after its index is taken by a new one
+	connect(manager, &ConnectionManager::stateChanged, this, [this, manager, index]
+			(QAbstractSocket::SocketState state) {
+		if (mManagers.value(index) == manager) {
+			Q_EMIT robotStateChanged(index, state);
+		}
+	});
+	connect(manager, &ConnectionManager::linkQualityChanged, this, [this, manager, index](const LinkQuality &quality) {
+		if (mManagers.value(index) == manager) {
+			Q_EMIT robotLinkQualityChanged(index, quality);
+		}
+	});
+	connect(manager, &ConnectionManager::protocolChanged, this, [this, manager, index](bool binary) {
+		if (mManagers.value(index) != manager) {
+			return;
+		}
+
+		if (binary) {
+			mBinaryRobots |= 1u << index;
+		} else {
+			mBinaryRobots &= ~(1u << index);
+		}
+	});
+
+	// Events posted before the thread starts are delivered once its event loop runs
+	QMetaObject::invokeMethod(manager, [manager]() { manager->init(); }, Qt::QueuedConnection);
+}
+
+int ConnectionPool::size() const
+{
+	return mManagers.size();
+}
+
+bool ConnectionPool::contains(int index) const
+{
+	return mManagers.value(index) != nullptr;
+}
+
+ConnectionManager *ConnectionPool::manager(int index) const
+{
+	return mManagers.value(index);
+}
+
+QString ConnectionPool::settingsPrefix(int index)
+{
+	return index == 0 ? QString() : QString("robots/%1/").arg(index);
+}
+
+void ConnectionPool::setSelected(int index, bool selected)
+{
+	if (selected) {
+		mSelected |= 1u << index;
+	} else {
+		mSelected &= ~(1u << index);
+	}
+}
+
+bool ConnectionPool::isSelected(int index) const
+{
+	return (mSelected & (1u << index)) != 0;
+}
+
+void ConnectionPool::dispatch(const CommandFrame &frame)
+{
+	const quint32 selected = mSelected;
+	if (selected == 0 || frame.isEmpty()) {
+		return;
+	}
+
+	// Each protocol is encoded at most once, whatever the number of robots speaking it
+	const quint32 binaryRobots = mBinaryRobots;
+	const bool needText = (selected & ~binaryRobots) != 0;
+	const bool needBinary = (selected & binaryRobots) != 0;
+	EncodedFrame encoded;
+	for (const auto &command : frame) {
+		auto stamped = command;
+		stamped.sequence = CommandCodec::nextSequence();
+		encoded.frame.append(stamped);
+		if (needText) {
+			mTextCodec.encode(stamped, encoded.text);
+		}
+
+		if (needBinary) {
+			mBinaryCodec.encode(stamped, encoded.binary);
+		}
+	}
+
+	Q_EMIT encodedFrameReady(encoded, selected);
+}
@@ -0,0 +1,110 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include <QtCore/QSettings>
+
+#include <atomic>
+
+#include "connectionManager.h"
+#include "encodedFrame.h"
+
+/// Connections to several robots driven in formation. All of them live in one network thread. Commands of
+/// strategy are encoded once and fanned out to the selected group of robots. Robot 0 is always present and uses
+/// the same settings as a single-robot gamepad. Other robots are kept in settings, so they come back on the next run
+/// with the same indices until removed.
+class ConnectionPool : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(ConnectionPool)
+
+public:
+	/// Maximal number of robots, each of them has a bit in selection mask
+	static constexpr int maxRobots = 32;
+
+	/// Creates pool with robot 0 and robots saved in settings, starts network thread
+	explicit ConnectionPool(QSettings *settings, QObject *parent = nullptr);
+	~ConnectionPool() override;
+
+	/// Adds a robot which settings are stored with settingsPrefix(index) at freeIndex(). Returns its index or -1
+	/// if the pool is full.
+	int addRobot();
+
+	/// Index the next added robot gets: the lowest one left by a removed robot or the one after the last robot,
+	/// -1 if the pool is full
+	int freeIndex() const;
+
+	/// Disconnects the robot and deletes its settings, so it is not restored on the next run. Robot 0 is never removed.
+	void removeRobot(int index);
+
+	/// Number of robot indices in use, some of them may be left free by removed robots
+	int size() const;
+
+	/// Returns true if there is a robot with given index
+	bool contains(int index) const;
+
+	/// Connection to the robot with given index, nullptr if there is no such robot. Lives in network thread,
+	/// so use queued calls only.
+	ConnectionManager *manager(int index) const;
+
+	/// Prefix of settings keys describing connection to the robot with given index
+	static QString settingsPrefix(int index);
+
+	/// Includes the robot in the group which receives commands or excludes it
+	void setSelected(int index, bool selected);
+
+	/// Returns true if the robot receives commands
+	bool isSelected(int index) const;
+
+public slots:
+	/// Encodes frame once and sends it to all selected robots. Thread-safe, so strategies running in control thread
+	/// call it directly.
+	void dispatch(const CommandFrame &frame);
+
+signals:
+	/// Emitted for every frame dispatched, robots is a mask of robot indices which shall send it
+	void encodedFrameReady(const EncodedFrame &frame, quint32 robots);
+
+	/// Emitted when socket state of the robot changes
+	void robotStateChanged(int index, QAbstractSocket::SocketState state);
+
+	/// Emitted when latency statistics of the robot is updated
+	void robotLinkQualityChanged(int index, const LinkQuality &quality);
+
+private:
+	/// Creates connection to the robot with given free index
+	void createRobot(int index);
+
+	QSettings *mSettings; // Doesn't have ownership
+
+	/// Thread shared by all connections
+	QThread mThread;
+
+	/// Connections to robots, nullptr for indices of removed robots. Ownership is passed to the thread, they are
+	/// deleted when it finishes.
+	QVector<ConnectionManager *> mManagers;
+
+	/// Mask of robots receiving commands
+	std::atomic<quint32> mSelected { 0 };
+
+	/// Mask of robots which negotiated binary protocol
+	std::atomic<quint32> mBinaryRobots { 0 };
+
+	CommandCodec mTextCodec { CommandCodec::Protocol::text };
+	CommandCodec mBinaryCodec { CommandCodec::Protocol::binary };
+};
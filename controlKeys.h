@@ -0,0 +1,92 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+#include <QtCore/qnamespace.h>
+
+/// Compact ids of the keys gamepad reacts to. Pressed keys fit into one bitmask and per-key data into plain arrays,
+/// so strategies need no hash lookups or containers on the hot path.
+namespace ControlKeys {
+
+/// Key id, keys of a pad go together, so the pad is a contiguous range of ids
+enum Id : quint8 {
+	w = 0
+	, a
+	, s
+	, d
+	, left
+	, up
+	, right
+	, down
+	, digit1
+	, digit2
+	, digit3
+	, digit4
+	, digit5
+	, none = 0xff
+};
+
+/// Number of control keys
+constexpr int count = digit5 + 1;
+
+/// Set of pressed keys, bit n is set if key with id n is pressed
+using Mask = quint16;
+
+/// Bit of given key in Mask
+constexpr Mask bit(int id)
+{
+	return static_cast<Mask>(1u << id);
+}
+
+/// Keys of pad 1, pad 2 and magic buttons
+constexpr Mask pad1Keys = bit(w) | bit(a) | bit(s) | bit(d);
+constexpr Mask pad2Keys = bit(left) | bit(up) | bit(right) | bit(down);
+constexpr Mask buttonKeys = bit(digit1) | bit(digit2) | bit(digit3) | bit(digit4) | bit(digit5);
+
+/// Id of Qt key, none if gamepad does not react to it
+constexpr Id idOf(int key)
+{
+	switch (key) {
+	case Qt::Key_W: return w;
+	case Qt::Key_A: return a;
+	case Qt::Key_S: return s;
+	case Qt::Key_D: return d;
+	case Qt::Key_Left: return left;
+	case Qt::Key_Up: return up;
+	case Qt::Key_Right: return right;
+	case Qt::Key_Down: return down;
+	case Qt::Key_1: return digit1;
+	case Qt::Key_2: return digit2;
+	case Qt::Key_3: return digit3;
+	case Qt::Key_4: return digit4;
+	case Qt::Key_5: return digit5;
+	default: return none;
+	}
+}
+
+/// Qt key with given id
+constexpr int keyOf(int id)
+{
+	constexpr int keys[count] = {
+		Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D
+		, Qt::Key_Left, Qt::Key_Up, Qt::Key_Right, Qt::Key_Down
+		, Qt::Key_1, Qt::Key_2, Qt::Key_3, Qt::Key_4, Qt::Key_5
+	};
+
+	return keys[id];
+}
+
+}
@@ -0,0 +1,136 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "controlScheduler.h"
+
+#include <QtCore/QLoggingCategory>
+
+namespace {
+
+/// Jitter log is for tuning, so it is off unless enabled by "trik.gamepad.jitter.debug=true" logging rule
+Q_LOGGING_CATEGORY(jitterLog, "trik.gamepad.jitter", QtInfoMsg)
+
+/// How often jitter is logged while the scheduler runs, in microseconds
+constexpr qint64 jitterLogInterval = 10 * 1000 * 1000;
+
+}
+
+constexpr int ControlScheduler::maxRate;
+
+ControlScheduler::ControlScheduler(QObject *parent)
+	: QObject(parent)
+	, mTimer(this)
+{
+	mTimer.setTimerType(Qt::PreciseTimer);
+	connect(&mTimer, &QTimer::timeout, this, &ControlScheduler::onTimeout);
+}
+
+void ControlScheduler::setRate(int rate)
+{
+	mRate = qBound(1, rate, maxRate);
+	mTimer.setInterval(1000 / mRate);
+}
+
+int ControlScheduler::rate() const
+{
+	return mRate;
+}
+
+void ControlScheduler::start()
+{
+	mClock.start();
+	mLastTickUs = 0;
+	mLogStartUs = 0;
+	mJitterTicks = 0;
+	mJitterSumUs = 0;
+	mJitterMaxUs = 0;
+	if (mVirtualClock) {
+		mLastTickUs = mVirtualNowUs;
+		mVirtualActive = true;
+	} else {
+		mTimer.start(1000 / mRate);
+	}
+}
+
+void ControlScheduler::stop()
+{
+	mTimer.stop();
+	mVirtualActive = false;
+}
+
+bool ControlScheduler::isActive() const
+{
+	return mVirtualClock ? mVirtualActive : mTimer.isActive();
+}
+
+void ControlScheduler::setVirtualClock(bool enabled)
+{
+	stop();
+	mVirtualClock = enabled;
+	mVirtualNowUs = 0;
+}
+
+qint64 ControlScheduler::nextTickAt() const
+{
+	// Same period as the timer has, it is whole milliseconds
+	return mVirtualClock && mVirtualActive ? mLastTickUs + 1000 / mRate * 1000LL : -1;
+}
+
+void ControlScheduler::advanceTo(qint64 timeUs)
+{
+	mVirtualNowUs = timeUs;
+	const qint64 next = nextTickAt();
+	if (next >= 0 && timeUs >= next) {
+		const qint64 elapsed = timeUs - mLastTickUs;
+		mLastTickUs = timeUs;
+		Q_EMIT tick(elapsed);
+	}
+}
+
+ControlScheduler::Jitter ControlScheduler::jitter() const
+{
+	Jitter result;
+	result.ticks = mJitterTicks;
+	result.meanUs = mJitterTicks ? mJitterSumUs / mJitterTicks : 0;
+	result.maxUs = mJitterMaxUs;
+	return result;
+}
+
+void ControlScheduler::onTimeout()
+{
+	const qint64 now = mClock.nsecsElapsed() / 1000;
+	const qint64 elapsed = now - mLastTickUs;
+	mLastTickUs = now;
+
+	const qint64 deviation = qAbs(elapsed - mTimer.interval() * 1000);
+	++mJitterTicks;
+	mJitterSumUs += deviation;
+	mJitterMaxUs = qMax(mJitterMaxUs, deviation);
+	if (now - mLogStartUs >= jitterLogInterval) {
+		logJitter();
+		mLogStartUs = now;
+	}
+
+	Q_EMIT tick(elapsed);
+}
+
+void ControlScheduler::logJitter()
+{
+	const auto stats = jitter();
+	qCDebug(jitterLog).noquote() << QString("Control tick jitter at %1 Hz over %2 ticks: mean %3 us, max %4 us")
+			.arg(mRate).arg(stats.ticks).arg(stats.meanUs).arg(stats.maxUs);
+	mJitterTicks = 0;
+	mJitterSumUs = 0;
+	mJitterMaxUs = 0;
+}
@@ -0,0 +1,88 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+/// Periodic control tick with measured time. Timer events come late by an arbitrary amount, so every tick carries
+/// the time elapsed since the previous one by QElapsedTimer, and consumers integrate over it instead of assuming
+/// a fixed period. Deviation of the measured period from the nominal one is collected and logged periodically.
+/// On a virtual clock there is no timer: time is moved by advanceTo() and ticks come at the nominal period of it,
+/// so replayed input gives the same ticks on every run.
+class ControlScheduler : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(ControlScheduler)
+
+public:
+	/// Highest supported control rate, in ticks per second
+	static constexpr int maxRate = 100;
+
+	/// Tick jitter statistics, in microseconds
+	struct Jitter {
+		int ticks {};
+		qint64 meanUs {};
+		qint64 maxUs {};
+	};
+
+	explicit ControlScheduler(QObject *parent = nullptr);
+
+	/// Sets control rate in ticks per second, clamped to [1, maxRate]. Takes effect immediately if running
+	void setRate(int rate);
+	int rate() const;
+
+	/// Starts ticking, the first tick measures time from this call
+	void start();
+	void stop();
+	bool isActive() const;
+
+	/// Switches to virtual clock starting from 0, or back to the timer. Stops the scheduler
+	void setVirtualClock(bool enabled);
+
+	/// Time of the next tick on the virtual clock in microseconds, -1 if the scheduler is stopped
+	qint64 nextTickAt() const;
+
+	/// Moves the virtual clock to given time in microseconds, emitting the tick if it is due by then
+	void advanceTo(qint64 timeUs);
+
+	/// Jitter of ticks since the last log line
+	Jitter jitter() const;
+
+signals:
+	/// Emitted every control period with time elapsed since the previous tick (or start), in microseconds
+	void tick(qint64 elapsedUs);
+
+private slots:
+	void onTimeout();
+
+private:
+	void logJitter();
+
+	QTimer mTimer; // Child, so it follows the scheduler to another thread
+	QElapsedTimer mClock;
+	int mRate { 50 };
+	qint64 mLastTickUs {};
+
+	bool mVirtualClock {};
+	bool mVirtualActive {};
+	qint64 mVirtualNowUs {};
+
+	qint64 mLogStartUs {};
+	int mJitterTicks {};
+	qint64 mJitterSumUs {};
+	qint64 mJitterMaxUs {};
+};
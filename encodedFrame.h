@@ -0,0 +1,35 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+
+#include "commandFrame.h"
+
+/// Frame encoded once for every robot it is sent to. Byte arrays are implicitly shared, so handing the frame to
+/// several connections does not copy them. A protocol nobody uses at the moment is left empty.
+struct EncodedFrame
+{
+	/// Commands of the frame with sequence numbers already assigned
+	CommandFrame frame;
+
+	/// Frame in text protocol
+	QByteArray text;
+
+	/// Frame in binary protocol
+	QByteArray binary;
+};
+
+Q_DECLARE_METATYPE(EncodedFrame)
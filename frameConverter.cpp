@@ -0,0 +1,445 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "frameConverter.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+#include <QtMultimedia/QVideoFrame>
+#ifdef TRIK_USE_QT6
+	#include <QtMultimedia/QVideoFrameFormat>
+#endif
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "poolTask.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define TRIK_X86_KERNELS
+	#include <immintrin.h>
+	#define TRIK_SSE2 __attribute__((target("sse2")))
+	#define TRIK_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+/// Coefficients of R = Y + 1.140 (V - 128), G = Y - 0.395 (U - 128) - 0.581 (V - 128), B = Y + 2.032 (U - 128),
+/// scaled by 2^shift. Products stay within 16 bits, so SIMD kernels multiply 8 or 16 pixels at once.
+constexpr int shift = 6;
+constexpr int rounding = 1 << (shift - 1);
+constexpr int rv = 73;
+constexpr int gu = 25;
+constexpr int gv = 37;
+constexpr int bu = 130;
+
+/// Samples of one row: Y of pixel x is y[x * yStep], its chroma is u[(x / 2) * uvStep] and v[(x / 2) * uvStep]
+struct Row {
+	const uchar *y;
+	const uchar *u;
+	const uchar *v;
+	int yStep;
+	int uvStep;
+};
+
+Row rowOf(const YuvImage &image, int index)
+{
+	const uchar *luma = image.data[0] + index * image.stride[0];
+	switch (image.layout) {
+	case YuvImage::Layout::i420:
+		return {luma, image.data[1] + index / 2 * image.stride[1], image.data[2] + index / 2 * image.stride[2], 1, 1};
+	case YuvImage::Layout::nv12: {
+		const uchar *chroma = image.data[1] + index / 2 * image.stride[1];
+		return {luma, chroma, chroma + 1, 1, 2};
+	}
+	case YuvImage::Layout::yuyv:
+		return {luma, luma + 1, luma + 3, 2, 4};
+	}
+
+	return {luma, luma, luma, 1, 0};
+}
+
+/// Rows in a band of parallel conversion, even so bands do not share chroma rows. A full HD band is about 0.5 MB
+/// of RGB, so bands are large enough to amortize task overhead and small enough to balance cores.
+constexpr int bandRows = 64;
+
+quint8 clamp(int value)
+{
+	return static_cast<quint8>(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+/// Converts pixels from first to last, not including it
+void convertScalar(const Row &row, QRgb *out, int first, int last)
+{
+	for (int x = first; x < last; ++x) {
+		const int y = row.y[x * row.yStep];
+		const int u = row.u[x / 2 * row.uvStep] - 128;
+		const int v = row.v[x / 2 * row.uvStep] - 128;
+		out[x] = qRgb(clamp(y + ((rv * v + rounding) >> shift))
+				, clamp(y - ((gu * u + gv * v + rounding) >> shift))
+				, clamp(y + ((bu * u + rounding) >> shift)));
+	}
+}
+
+#ifdef TRIK_X86_KERNELS
+
+// Helpers are functions rather than lambdas, since lambdas do not inherit target attribute of the kernel
+
+TRIK_SSE2 __m128i loadSse2(const uchar *data)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+
+TRIK_SSE2 __m128i loadWidenedSse2(const uchar *data)
+{
+	return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(data)), _mm_setzero_si128());
+}
+
+/// Adds chroma term, shared by pixel pairs, to 16 luma values and saturates them to bytes
+TRIK_SSE2 __m128i channelSse2(__m128i yLow, __m128i yHigh, __m128i delta)
+{
+	return _mm_packus_epi16(_mm_add_epi16(yLow, _mm_unpacklo_epi16(delta, delta))
+			, _mm_add_epi16(yHigh, _mm_unpackhi_epi16(delta, delta)));
+}
+
+/// Chroma term of 8 pixel pairs
+TRIK_SSE2 __m128i termSse2(__m128i u, int uFactor, __m128i v, int vFactor)
+{
+	const __m128i sum = _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(static_cast<short>(uFactor)))
+			, _mm_mullo_epi16(v, _mm_set1_epi16(static_cast<short>(vFactor))));
+	return _mm_srai_epi16(_mm_add_epi16(sum, _mm_set1_epi16(rounding)), shift);
+}
+
+/// Converts 16 pixels: y holds 16 luma bytes, u and v hold 8 chroma samples as 16-bit numbers
+TRIK_SSE2 void pixelsSse2(__m128i y, __m128i u, __m128i v, uchar *out)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(128);
+	u = _mm_sub_epi16(u, bias);
+	v = _mm_sub_epi16(v, bias);
+	const __m128i yLow = _mm_unpacklo_epi8(y, zero);
+	const __m128i yHigh = _mm_unpackhi_epi8(y, zero);
+	const __m128i r = channelSse2(yLow, yHigh, termSse2(u, 0, v, rv));
+	const __m128i g = channelSse2(yLow, yHigh, _mm_sub_epi16(zero, termSse2(u, gu, v, gv)));
+	const __m128i b = channelSse2(yLow, yHigh, termSse2(u, bu, v, 0));
+
+	// RGB32 is B, G, R, 0xff in memory
+	const __m128i alpha = _mm_set1_epi8(-1);
+	const __m128i bgLow = _mm_unpacklo_epi8(b, g);
+	const __m128i bgHigh = _mm_unpackhi_epi8(b, g);
+	const __m128i raLow = _mm_unpacklo_epi8(r, alpha);
+	const __m128i raHigh = _mm_unpackhi_epi8(r, alpha);
+	auto pixels = reinterpret_cast<__m128i *>(out);
+	_mm_storeu_si128(pixels, _mm_unpacklo_epi16(bgLow, raLow));
+	_mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(bgLow, raLow));
+	_mm_storeu_si128(pixels + 2, _mm_unpacklo_epi16(bgHigh, raHigh));
+	_mm_storeu_si128(pixels + 3, _mm_unpackhi_epi16(bgHigh, raHigh));
+}
+
+TRIK_SSE2 void convertSse2(YuvImage::Layout layout, const Row &row, QRgb *out, int width)
+{
+	const __m128i lowBytes = _mm_set1_epi16(0xff);
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		switch (layout) {
+		case YuvImage::Layout::i420:
+			pixelsSse2(loadSse2(row.y + x), loadWidenedSse2(row.u + x / 2), loadWidenedSse2(row.v + x / 2)
+					, reinterpret_cast<uchar *>(out + x));
+			break;
+		case YuvImage::Layout::nv12: {
+			const __m128i uv = loadSse2(row.u + x);
+			pixelsSse2(loadSse2(row.y + x), _mm_and_si128(uv, lowBytes), _mm_srli_epi16(uv, 8)
+					, reinterpret_cast<uchar *>(out + x));
+			break;
+		}
+		case YuvImage::Layout::yuyv: {
+			const __m128i first = loadSse2(row.y + 2 * x);
+			const __m128i second = loadSse2(row.y + 2 * x + 16);
+			const __m128i y = _mm_packus_epi16(_mm_and_si128(first, lowBytes), _mm_and_si128(second, lowBytes));
+			const __m128i uv = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+			pixelsSse2(y, _mm_and_si128(uv, lowBytes), _mm_srli_epi16(uv, 8), reinterpret_cast<uchar *>(out + x));
+			break;
+		}
+		}
+	}
+
+	convertScalar(row, out, x, width);
+}
+
+/// AVX2 versions work on 32 pixels. Unpacking and packing act within 128-bit halves, so luma is split into
+/// pixels 0-7 and 16-23 in one register and 8-15 and 24-31 in another, which matches how chroma is duplicated.
+TRIK_AVX2 __m256i loadAvx2(const uchar *data)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+}
+
+TRIK_AVX2 __m256i loadWidenedAvx2(const uchar *data)
+{
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+}
+
+TRIK_AVX2 __m256i channelAvx2(__m256i yLow, __m256i yHigh, __m256i delta)
+{
+	return _mm256_packus_epi16(_mm256_add_epi16(yLow, _mm256_unpacklo_epi16(delta, delta))
+			, _mm256_add_epi16(yHigh, _mm256_unpackhi_epi16(delta, delta)));
+}
+
+TRIK_AVX2 __m256i termAvx2(__m256i u, int uFactor, __m256i v, int vFactor)
+{
+	const __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(u, _mm256_set1_epi16(static_cast<short>(uFactor)))
+			, _mm256_mullo_epi16(v, _mm256_set1_epi16(static_cast<short>(vFactor))));
+	return _mm256_srai_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(rounding)), shift);
+}
+
+/// Converts 32 pixels: y holds 32 luma bytes, u and v hold 16 chroma samples as 16-bit numbers in order
+TRIK_AVX2 void pixelsAvx2(__m256i y, __m256i u, __m256i v, uchar *out)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i bias = _mm256_set1_epi16(128);
+	u = _mm256_sub_epi16(u, bias);
+	v = _mm256_sub_epi16(v, bias);
+	const __m256i yLow = _mm256_unpacklo_epi8(y, zero);
+	const __m256i yHigh = _mm256_unpackhi_epi8(y, zero);
+	const __m256i r = channelAvx2(yLow, yHigh, termAvx2(u, 0, v, rv));
+	const __m256i g = channelAvx2(yLow, yHigh, _mm256_sub_epi16(zero, termAvx2(u, gu, v, gv)));
+	const __m256i b = channelAvx2(yLow, yHigh, termAvx2(u, bu, v, 0));
+
+	const __m256i alpha = _mm256_set1_epi8(-1);
+	const __m256i bgLow = _mm256_unpacklo_epi8(b, g);
+	const __m256i bgHigh = _mm256_unpackhi_epi8(b, g);
+	const __m256i raLow = _mm256_unpacklo_epi8(r, alpha);
+	const __m256i raHigh = _mm256_unpackhi_epi8(r, alpha);
+
+	// Halves hold pixels 0-3 and 16-19, 4-7 and 20-23, 8-11 and 24-27, 12-15 and 28-31
+	const __m256i first = _mm256_unpacklo_epi16(bgLow, raLow);
+	const __m256i second = _mm256_unpackhi_epi16(bgLow, raLow);
+	const __m256i third = _mm256_unpacklo_epi16(bgHigh, raHigh);
+	const __m256i fourth = _mm256_unpackhi_epi16(bgHigh, raHigh);
+	auto pixels = reinterpret_cast<__m256i *>(out);
+	_mm256_storeu_si256(pixels, _mm256_permute2x128_si256(first, second, 0x20));
+	_mm256_storeu_si256(pixels + 1, _mm256_permute2x128_si256(third, fourth, 0x20));
+	_mm256_storeu_si256(pixels + 2, _mm256_permute2x128_si256(first, second, 0x31));
+	_mm256_storeu_si256(pixels + 3, _mm256_permute2x128_si256(third, fourth, 0x31));
+}
+
+TRIK_AVX2 void convertAvx2(YuvImage::Layout layout, const Row &row, QRgb *out, int width)
+{
+	const __m256i lowBytes = _mm256_set1_epi16(0xff);
+	int x = 0;
+	for (; x + 32 <= width; x += 32) {
+		switch (layout) {
+		case YuvImage::Layout::i420:
+			pixelsAvx2(loadAvx2(row.y + x), loadWidenedAvx2(row.u + x / 2), loadWidenedAvx2(row.v + x / 2)
+					, reinterpret_cast<uchar *>(out + x));
+			break;
+		case YuvImage::Layout::nv12: {
+			const __m256i uv = loadAvx2(row.u + x);
+			pixelsAvx2(loadAvx2(row.y + x), _mm256_and_si256(uv, lowBytes), _mm256_srli_epi16(uv, 8)
+					, reinterpret_cast<uchar *>(out + x));
+			break;
+		}
+		case YuvImage::Layout::yuyv: {
+			// Packing interleaves 64-bit quarters of both registers, permutation restores pixel order
+			const __m256i first = loadAvx2(row.y + 2 * x);
+			const __m256i second = loadAvx2(row.y + 2 * x + 32);
+			const __m256i y = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(first, lowBytes)
+					, _mm256_and_si256(second, lowBytes)), 0xd8);
+			const __m256i uv = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(first, 8)
+					, _mm256_srli_epi16(second, 8)), 0xd8);
+			pixelsAvx2(y, _mm256_and_si256(uv, lowBytes), _mm256_srli_epi16(uv, 8)
+					, reinterpret_cast<uchar *>(out + x));
+			break;
+		}
+		}
+	}
+
+	convertScalar(row, out, x, width);
+}
+
+#endif
+
+}
+
+bool FrameConverter::isSupported(Kernel kernel)
+{
+	switch (kernel) {
+	case Kernel::scalar:
+		return true;
+#ifdef TRIK_X86_KERNELS
+	case Kernel::sse2:
+		return __builtin_cpu_supports("sse2");
+	case Kernel::avx2:
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return false;
+	}
+}
+
+FrameConverter::Kernel FrameConverter::bestKernel()
+{
+	static const Kernel best = isSupported(Kernel::avx2)
+			? Kernel::avx2
+			: isSupported(Kernel::sse2) ? Kernel::sse2 : Kernel::scalar;
+	return best;
+}
+
+const char *FrameConverter::name(Kernel kernel)
+{
+	switch (kernel) {
+	case Kernel::scalar:
+		return "scalar";
+	case Kernel::sse2:
+		return "SSE2";
+	case Kernel::avx2:
+		return "AVX2";
+	}
+
+	return "";
+}
+
+void FrameConverter::convert(const YuvImage &image, uchar *rgb, int rgbStride, int firstRow, int lastRow
+		, Kernel kernel)
+{
+	if (!isSupported(kernel)) {
+		kernel = Kernel::scalar;
+	}
+
+	for (int i = firstRow; i < lastRow; ++i) {
+		const auto &samples = rowOf(image, i);
+		auto out = reinterpret_cast<QRgb *>(rgb + i * rgbStride);
+		switch (kernel) {
+#ifdef TRIK_X86_KERNELS
+		case Kernel::sse2:
+			convertSse2(image.layout, samples, out, image.width);
+			break;
+		case Kernel::avx2:
+			convertAvx2(image.layout, samples, out, image.width);
+			break;
+#endif
+		default:
+			convertScalar(samples, out, 0, image.width);
+			break;
+		}
+	}
+}
+
+void FrameConverter::convertParallel(const YuvImage &image, uchar *rgb, int rgbStride, QThreadPool &pool
+		, Kernel kernel)
+{
+	const int bands = (image.height + bandRows - 1) / bandRows;
+	const int helpers = qMin(bands, pool.maxThreadCount()) - 1;
+	if (helpers <= 0) {
+		convert(image, rgb, rgbStride, 0, image.height, kernel);
+		return;
+	}
+
+	// Helpers may start after all bands are done and the call has returned, so they share state by pointer
+	struct Progress {
+		std::atomic<int> next { 0 };
+		std::atomic<int> done { 0 };
+		QMutex mutex;
+		QWaitCondition finished;
+	};
+
+	const auto progress = std::make_shared<Progress>();
+	const auto work = [=]() {
+		for (int band = progress->next++; band < bands; band = progress->next++) {
+			convert(image, rgb, rgbStride, band * bandRows, qMin(image.height, (band + 1) * bandRows), kernel);
+			if (++progress->done == bands) {
+				QMutexLocker locker(&progress->mutex);
+				progress->finished.wakeAll();
+			}
+		}
+	};
+
+	for (int i = 0; i < helpers; ++i) {
+		pool.start(new PoolTask(work));
+	}
+
+	work();
+	QMutexLocker locker(&progress->mutex);
+	while (progress->done < bands) {
+		progress->finished.wait(&progress->mutex);
+	}
+}
+
+QImage FrameConverter::toImage(const YuvImage &image, QThreadPool *pool)
+{
+	QImage result(image.width, image.height, QImage::Format_RGB32);
+	if (pool) {
+		convertParallel(image, result.bits(), result.bytesPerLine(), *pool);
+	} else {
+		convert(image, result.bits(), result.bytesPerLine(), 0, image.height);
+	}
+
+	return result;
+}
+
+bool FrameConverter::describe(const QVideoFrame &frame, YuvImage &image)
+{
+	bool swapChroma = false;
+	switch (frame.pixelFormat()) {
+#ifdef TRIK_USE_QT6
+	case QVideoFrameFormat::Format_YV12:
+		swapChroma = true;
+		Q_FALLTHROUGH();
+	case QVideoFrameFormat::Format_YUV420P:
+		image.layout = YuvImage::Layout::i420;
+		break;
+	case QVideoFrameFormat::Format_NV12:
+		image.layout = YuvImage::Layout::nv12;
+		break;
+	case QVideoFrameFormat::Format_YUYV:
+		image.layout = YuvImage::Layout::yuyv;
+		break;
+#else
+	case QVideoFrame::Format_YV12:
+		swapChroma = true;
+		Q_FALLTHROUGH();
+	case QVideoFrame::Format_YUV420P:
+		image.layout = YuvImage::Layout::i420;
+		break;
+	case QVideoFrame::Format_NV12:
+		image.layout = YuvImage::Layout::nv12;
+		break;
+	case QVideoFrame::Format_YUYV:
+		image.layout = YuvImage::Layout::yuyv;
+		break;
+#endif
+	default:
+		return false;
+	}
+
+	image.width = frame.width();
+	image.height = frame.height();
+	const int planes = image.layout == YuvImage::Layout::i420 ? 3 : image.layout == YuvImage::Layout::nv12 ? 2 : 1;
+	if (frame.planeCount() < planes) {
+		return false;
+	}
+
+	for (int i = 0; i < planes; ++i) {
+		image.data[i] = frame.bits(i);
+		image.stride[i] = frame.bytesPerLine(i);
+	}
+
+	if (swapChroma) {
+		std::swap(image.data[1], image.data[2]);
+		std::swap(image.stride[1], image.stride[2]);
+	}
+
+	return true;
+}
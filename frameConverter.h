@@ -0,0 +1,74 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtGui/QImage>
+
+class QThreadPool;
+class QVideoFrame;
+
+/// YUV picture in memory, as a video frame maps it. Chroma is subsampled horizontally by 2, and vertically by 2
+/// for 4:2:0 layouts. Strides are in bytes and may be larger than the row.
+struct YuvImage {
+	enum class Layout {
+		i420 ///< planes Y, U, V; YV12 is the same with U and V planes swapped
+		, nv12 ///< planes Y and interleaved UV
+		, yuyv ///< one plane of Y0 U Y1 V quadruples, 4:2:2
+	};
+
+	Layout layout { Layout::i420 };
+	int width {};
+	int height {};
+	const uchar *data[3] {};
+	int stride[3] {};
+};
+
+/// Converts YUV pictures to RGB32 with fixed-point BT.601 coefficients. Kernels use SSE2 or AVX2 where the CPU
+/// supports them and produce exactly the same pixels as the scalar one, which is used everywhere else.
+class FrameConverter
+{
+public:
+	enum class Kernel {
+		scalar
+		, sse2
+		, avx2
+	};
+
+	/// Returns true if the kernel is built in and the CPU supports it
+	static bool isSupported(Kernel kernel);
+
+	/// The fastest supported kernel
+	static Kernel bestKernel();
+
+	/// Name of the kernel for reports
+	static const char *name(Kernel kernel);
+
+	/// Converts rows from firstRow to lastRow, not including it, into RGB32 pixels. rgb points to the first pixel
+	/// of row 0. firstRow shall be even unless the layout is yuyv.
+	static void convert(const YuvImage &image, uchar *rgb, int rgbStride, int firstRow, int lastRow
+			, Kernel kernel = bestKernel());
+
+	/// Converts the whole picture splitting it into bands of rows which threads of the pool convert in parallel.
+	/// The calling thread converts bands too, so it never waits for a band no thread has started, and the call
+	/// is safe from a thread of the same pool.
+	static void convertParallel(const YuvImage &image, uchar *rgb, int rgbStride, QThreadPool &pool
+			, Kernel kernel = bestKernel());
+
+	/// Converts the whole picture into a new image of Format_RGB32, in parallel if pool is given
+	static QImage toImage(const YuvImage &image, QThreadPool *pool = nullptr);
+
+	/// Describes planes of a mapped frame. Returns false if its pixel format is not a supported YUV one.
+	static bool describe(const QVideoFrame &frame, YuvImage &image);
+};
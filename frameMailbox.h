@@ -0,0 +1,69 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMutex>
+
+#include <atomic>
+#include <utility>
+
+/// Slot for one frame between two stages of video pipeline working in different threads. A frame put replaces
+/// the one not taken yet, which is counted as dropped, so a consumer that falls behind gets the newest frame instead
+/// of a backlog. Frames are implicitly shared Qt containers, so the lock is held only to swap references.
+template <typename Frame>
+class FrameMailbox
+{
+public:
+	/// Puts frame into the slot. Returns true if the slot was empty, so the consumer shall be notified; otherwise
+	/// it was notified already and will get this frame instead of the replaced one.
+	bool put(Frame frame)
+	{
+		QMutexLocker locker(&mMutex);
+		const bool wasEmpty = !mFull;
+		if (!wasEmpty) {
+			++mDropped;
+		}
+
+		mFrame = std::move(frame);
+		mFull = true;
+		return wasEmpty;
+	}
+
+	/// Takes the frame out of the slot, returns false if it is empty
+	bool take(Frame &frame)
+	{
+		QMutexLocker locker(&mMutex);
+		if (!mFull) {
+			return false;
+		}
+
+		frame = std::move(mFrame);
+		mFrame = Frame();
+		mFull = false;
+		return true;
+	}
+
+	/// Number of frames replaced before they were taken. Safe to call from any thread.
+	qint64 dropped() const
+	{
+		return mDropped;
+	}
+
+private:
+	QMutex mMutex;
+	Frame mFrame {}; // Guarded by mMutex
+	bool mFull {}; // Guarded by mMutex
+	std::atomic<qint64> mDropped { 0 };
+};
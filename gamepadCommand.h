@@ -0,0 +1,117 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QMetaType>
+
+/// Single gamepad command, independent of the wire protocol used to deliver it to the robot.
+struct GamepadCommand
+{
+	/// Kind of command. Values are used as type tags in the binary protocol, so do not reorder them.
+	enum class Type : quint8 {
+		invalid = 0
+		, pad
+		, padUp
+		, button
+		, keepalive
+		, protocol
+		, ping
+		, echo
+	};
+
+	/// "pad <id> <x> <y>" command
+	static GamepadCommand pad(int padId, int x, int y)
+	{
+		GamepadCommand command;
+		command.type = Type::pad;
+		command.id = static_cast<quint8>(padId);
+		command.x = static_cast<qint8>(x);
+		command.y = static_cast<qint8>(y);
+		return command;
+	}
+
+	/// "pad <id> up" command
+	static GamepadCommand padUp(int padId)
+	{
+		GamepadCommand command;
+		command.type = Type::padUp;
+		command.id = static_cast<quint8>(padId);
+		return command;
+	}
+
+	/// "btn <id>" command
+	static GamepadCommand button(int buttonId)
+	{
+		GamepadCommand command;
+		command.type = Type::button;
+		command.id = static_cast<quint8>(buttonId);
+		return command;
+	}
+
+	/// "keepalive <timeout>" command, timeout is in milliseconds
+	static GamepadCommand keepalive(int timeout)
+	{
+		GamepadCommand command;
+		command.type = Type::keepalive;
+		command.value = static_cast<quint16>(timeout);
+		return command;
+	}
+
+	/// "protocol <version>" command, used to negotiate wire protocol right after connection
+	static GamepadCommand protocol(int version)
+	{
+		GamepadCommand command;
+		command.type = Type::protocol;
+		command.value = static_cast<quint16>(version);
+		return command;
+	}
+
+	/// "ping <token>" command, the robot answers it with "echo <token>" if it supports latency probing
+	static GamepadCommand ping(int token)
+	{
+		GamepadCommand command;
+		command.type = Type::ping;
+		command.value = static_cast<quint16>(token);
+		return command;
+	}
+
+	/// "echo <token>" answer to ping command
+	static GamepadCommand echo(int token)
+	{
+		GamepadCommand command;
+		command.type = Type::echo;
+		command.value = static_cast<quint16>(token);
+		return command;
+	}
+
+	/// Kind of this command
+	Type type { Type::invalid };
+
+	/// Pad or button id
+	quint8 id {};
+
+	/// Pad coordinates, from -100 to 100
+	qint8 x {};
+	qint8 y {};
+
+	/// Keepalive timeout, protocol version or ping token
+	quint16 value {};
+
+	/// Sequence number assigned by sender, transferred by the binary protocol only
+	quint16 sequence {};
+};
+
+Q_DECLARE_METATYPE(GamepadCommand)
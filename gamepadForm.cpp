@@ -24,38 +24,64 @@
 
 #include <QtNetwork/QNetworkRequest>
 #include <QtGui/QFontDatabase>
+#include <QtGui/QScreen>
 
 #ifdef TRIK_USE_QT6
 #else
 	#include <QtMultimedia/QMediaContent>
 #endif
 
+#include <QtCore/QMimeData>
+
+#include "screenshotWorker.h"
+
 GamepadForm::GamepadForm()
 	: mUi(new Ui::GamepadForm())
-	, strategy(Strategy::getStrategy(Strategies::standartStrategy,this))
 	, mSettings(QSettings::Format::NativeFormat, QSettings::Scope::UserScope, "CyberTech Labs", "desktop-gamepad")
 {
 	mUi->setupUi(this);
 	this->installEventFilter(this);
-	connectionManager = new ConnectionManager(&mSettings);
-	/// passing this to QTcpSocket allows `socket` to be moved
-	/// to another thread with the parent
-	/// when connectionManager.moveToThread() is called
-	qRegisterMetaType<QAbstractSocket::SocketState>();
-	connectionManager->moveToThread(&thread);
+	connectionPool = new ConnectionPool(&mSettings, this);
+	connectionManager = connectionPool->manager(0);
+
+	strategyController = new StrategyController(this);
+	strategyController->setRefreshInterval(mSettings.value("padRefreshInterval"
+			, PadDeltaFilter::defaultRefreshInterval).toInt());
+	strategyController->setStrategy(Strategy::getStrategy(Strategies::standartStrategy, nullptr));
+	const auto &inputRecordFile = mSettings.value("inputRecordFile").toString();
+	if (!inputRecordFile.isEmpty()) {
+		strategyController->startRecording(inputRecordFile);
+	}
+
 	connect(this, &GamepadForm::newConnectionParameters, this, &GamepadForm::restartVideoStream);
 	connect(this, &GamepadForm::newConnectionParameters, connectionManager, &ConnectionManager::reconnectToHost);
-	connect(&thread, &QThread::started, connectionManager, &ConnectionManager::init);
-	connect(&thread, &QThread::finished, connectionManager, &ConnectionManager::deleteLater);
 	setUpGamepadForm();
-	thread.start();
+	setUpJoystick();
+
+	// Every robot with saved address was driven last time, so all of them are connected at once. The first one
+	// brings its video back too.
+	if (mSettings.contains("gamepadIp")) {
+		QMetaObject::invokeMethod(this, "newConnectionParameters", Qt::QueuedConnection);
+	}
+
+	for (int i = 1; i < connectionPool->size(); ++i) {
+		if (connectionPool->contains(i)) {
+			QMetaObject::invokeMethod(connectionPool->manager(i), "reconnectToHost", Qt::QueuedConnection);
+		}
+	}
 }
 
 GamepadForm::~GamepadForm()
 {
-	thread.quit();
-	thread.wait();
+	// Joystick thread feeds control thread, control thread dispatches frames to the pool, so they stop in this
+	// order. Then network thread is stopped before the form it reports to is gone.
+	delete joystickInput;
+	delete strategyController;
+	delete connectionPool;
 
+	// The view takes frames from the client, so it goes first
+	delete frameView;
+	delete mjpegClient;
 	delete player;
 	delete mUi;
 }
@@ -77,7 +103,7 @@ void GamepadForm::setUpGamepadForm()
 {
 	createMenu();
 	setFontToPadButtons();
-	setUpControlButtonsHash();
+	setUpControlButtons();
 	createConnection();
 	setVideoController();
 	setLabels();
@@ -87,27 +113,40 @@ void GamepadForm::setUpGamepadForm()
 
 void GamepadForm::setVideoController()
 {
-	videoWidget = new QVideoWidget(this);
-	videoWidget->setMinimumSize(320, 240);
-	videoWidget->setVisible(false);
-	mUi->verticalLayout->addWidget(videoWidget);
-	mUi->verticalLayout->setAlignment(videoWidget, Qt::AlignCenter);
+	// Media player backends buffer the stream, built-in client shows every frame as soon as it is decoded
+	if (mSettings.value("videoBackend").toString() == "mjpeg") {
+		mjpegClient = new MjpegStreamClient(this);
+		frameView = new VideoFrameView(mjpegClient, this);
+		videoView = frameView;
+		connect(mjpegClient, &MjpegStreamClient::stateChanged, this, &GamepadForm::handleMjpegStateChanged);
+		connect(mjpegClient, &MjpegStreamClient::statisticsChanged, this, &GamepadForm::showVideoStatistics);
+	} else {
+		videoWidget = new QVideoWidget(this);
+		videoView = videoWidget;
+	}
+
+	videoView->setMinimumSize(320, 240);
+	videoView->setVisible(false);
+	mUi->verticalLayout->addWidget(videoView);
+	mUi->verticalLayout->setAlignment(videoView, Qt::AlignCenter);
 
+	if (videoWidget) {
 #ifdef TRIK_USE_QT6
-	player = new QMediaPlayer(videoWidget);
+		player = new QMediaPlayer(videoWidget);
 #else
-	player = new QMediaPlayer(videoWidget, QMediaPlayer::StreamPlayback);
+		player = new QMediaPlayer(videoWidget, QMediaPlayer::StreamPlayback);
 #endif
 
-	connect(player, &QMediaPlayer::mediaStatusChanged, this, &GamepadForm::handleMediaStatusChanged);
+		connect(player, &QMediaPlayer::mediaStatusChanged, this, &GamepadForm::handleMediaStatusChanged);
 #ifdef TRIK_USE_QT6
-	connect(player, &QMediaPlayer::errorOccurred, this, &GamepadForm::handleMediaPlayerError);
+		connect(player, &QMediaPlayer::errorOccurred, this, &GamepadForm::handleMediaPlayerError);
 #else
-	connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error)
-			, this, &GamepadForm::handleMediaPlayerError);
+		connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error)
+				, this, &GamepadForm::handleMediaPlayerError);
 #endif
 
-	player->setVideoOutput(videoWidget);
+		player->setVideoOutput(videoWidget);
+	}
 
 	movie.setFileName(":/images/loading.gif");
 	mUi->loadingMediaLabel->setVisible(false);
@@ -129,18 +168,21 @@ void GamepadForm::handleMediaStatusChanged(QMediaPlayer::MediaStatus status)
 	case QMediaPlayer::StalledMedia:
 	case QMediaPlayer::LoadedMedia:
 	case QMediaPlayer::BufferingMedia:
-		player->play();
+		if (player) {
+			player->play();
+		}
+
 		mTakeImageAction->setEnabled(true);
 		mUi->loadingMediaLabel->setVisible(false);
 		mUi->invalidMediaLabel->setVisible(false);
 		mUi->label->setVisible(false);
-		videoWidget->setVisible(true);
+		videoView->setVisible(true);
 		break;
 
 	case QMediaPlayer::LoadingMedia:
 		mUi->invalidMediaLabel->setVisible(false);
 		mUi->label->setVisible(false);
-		videoWidget->setVisible(false);
+		videoView->setVisible(false);
 		mUi->loadingMediaLabel->setVisible(true);
 		movie.setPaused(false);
 		break;
@@ -148,7 +190,7 @@ void GamepadForm::handleMediaStatusChanged(QMediaPlayer::MediaStatus status)
 	case QMediaPlayer::InvalidMedia:
 		mUi->loadingMediaLabel->setVisible(false);
 		mUi->label->setVisible(false);
-		videoWidget->setVisible(false);
+		videoView->setVisible(false);
 		mUi->invalidMediaLabel->setVisible(true);
 		break;
 
@@ -156,7 +198,7 @@ void GamepadForm::handleMediaStatusChanged(QMediaPlayer::MediaStatus status)
 	case QMediaPlayer::EndOfMedia:
 		mUi->loadingMediaLabel->setVisible(false);
 		mUi->invalidMediaLabel->setVisible(false);
-		videoWidget->setVisible(false);
+		videoView->setVisible(false);
 		mUi->label->setVisible(true);
 		break;
 
@@ -170,10 +212,56 @@ void GamepadForm::handleMediaPlayerError(QMediaPlayer::Error error)
 	qDebug() << "ERROR:" << error << player->errorString();
 }
 
+void GamepadForm::handleMjpegStateChanged(MjpegStreamClient::State state)
+{
+	switch (state) {
+	case MjpegStreamClient::State::connecting:
+		handleMediaStatusChanged(QMediaPlayer::LoadingMedia);
+		break;
+	case MjpegStreamClient::State::streaming:
+		handleMediaStatusChanged(QMediaPlayer::LoadedMedia);
+		break;
+	case MjpegStreamClient::State::failed:
+		handleMediaStatusChanged(QMediaPlayer::InvalidMedia);
+		break;
+	case MjpegStreamClient::State::idle:
+		handleMediaStatusChanged(QMediaPlayer::NoMedia);
+		break;
+	}
+}
+
+void GamepadForm::showVideoStatistics(const VideoStatistics &statistics)
+{
+	const QString cpuTime = statistics.cpuTime < 0 ? tr("unknown") : QString::number(statistics.cpuTime, 'f', 1);
+	frameView->setToolTip(tr("Video frames are decoded at 1/%1 scale, %2x%3.\n"
+			"Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.\n"
+			"Frames are shown %7 ms after they are received on average, %8 ms at most.\n"
+			"Frames dropped as outdated: %9 before decoding, %10 before showing.")
+			.arg(statistics.scale)
+			.arg(statistics.size.width())
+			.arg(statistics.size.height())
+			.arg(statistics.decodeTime, 0, 'f', 1)
+			.arg(cpuTime)
+			.arg(statistics.frames)
+			.arg(statistics.meanAge, 0, 'f', 1)
+			.arg(statistics.maxAge, 0, 'f', 1)
+			.arg(statistics.droppedBeforeDecoding)
+			.arg(statistics.droppedBeforePresenting));
+}
+
 void GamepadForm::restartVideoStream()
 {
 	const auto &cIp = mSettings.value("cameraIp").toString();
 	const auto &cPort = mSettings.value("cameraPort").toString();
+	if (mjpegClient) {
+		const auto state = mjpegClient->state();
+		if (state == MjpegStreamClient::State::idle || state == MjpegStreamClient::State::failed) {
+			mjpegClient->start(cIp, cPort.toUShort());
+		}
+
+		return;
+	}
+
 	const auto status = player->mediaStatus();
 	if (status == QMediaPlayer::NoMedia || status == QMediaPlayer::EndOfMedia || status == QMediaPlayer::InvalidMedia) {
 		const QString url = "http://" + cIp + ":" + cPort + "/?action=stream&filename=noname.jpg";
@@ -192,6 +280,7 @@ void GamepadForm::checkSocket(QAbstractSocket::SocketState state)
 {
 	switch (state) {
 	case QAbstractSocket::ConnectedState:
+		mUi->linkQualityLabel->clear();
 		mUi->disconnectedLabel->setVisible(false);
 		mUi->connectedLabel->setVisible(true);
 		mUi->connectingLabel->setVisible(false);
@@ -209,6 +298,7 @@ void GamepadForm::checkSocket(QAbstractSocket::SocketState state)
 
 	case QAbstractSocket::UnconnectedState:
 	default:
+		mUi->linkQualityLabel->clear();
 		mUi->disconnectedLabel->setVisible(true);
 		mUi->connectedLabel->setVisible(false);
 		mUi->connectingLabel->setVisible(false);
@@ -226,6 +316,21 @@ void GamepadForm::checkBytesWritten(int result)
 	}
 }
 
+void GamepadForm::showLinkQuality(const LinkQuality &quality)
+{
+	mUi->linkQualityLabel->setText(tr("RTT %1/%2/%3 ms, jitter %4 ms, loss %5%")
+			.arg(quality.rttP50, 0, 'f', 1)
+			.arg(quality.rttP95, 0, 'f', 1)
+			.arg(quality.rttP99, 0, 'f', 1)
+			.arg(quality.jitter, 0, 'f', 1)
+			.arg(quality.loss * 100, 0, 'f', 0));
+	mUi->linkQualityLabel->setToolTip(tr("Round-trip time median, 95th and 99th percentiles over %1 probes.\n"
+			"Pad commands sent: %2, not sent as unchanged: %3")
+			.arg(quality.samples)
+			.arg(strategyController->sentPads())
+			.arg(strategyController->suppressedPads()));
+}
+
 void GamepadForm::showConnectionFailedMessage()
 {
 	QMessageBox failedConnectionMessage(this);
@@ -251,24 +356,56 @@ void GamepadForm::setFontToPadButtons()
 	mUi->buttonPad2Right->setFont(font);
 }
 
-void GamepadForm::setButtonChecked(const int &key, bool checkStatus)
+void GamepadForm::setButtonChecked(int id, bool checkStatus)
+{
+	if (checkStatus) {
+		mCheckedKeys |= ControlKeys::bit(id);
+	} else {
+		mCheckedKeys &= static_cast<ControlKeys::Mask>(~ControlKeys::bit(id));
+	}
+
+	if (!mRepaintTimer.isActive()) {
+		mRepaintTimer.start();
+	}
+}
+
+void GamepadForm::repaintControlButtons()
 {
-	controlButtonsHash[key]->setChecked(checkStatus);
+	for (int id = 0; id < ControlKeys::count; ++id) {
+		const bool checked = (mCheckedKeys & ControlKeys::bit(id)) != 0;
+		auto button = mControlButtons[static_cast<size_t>(id)];
+		if (button && button->isChecked() != checked) {
+			button->setChecked(checked);
+		}
+	}
 }
 
 void GamepadForm::createConnection()
 {
-	for (auto &&button : controlButtonsHash) {
-		connect(button, &QPushButton::pressed, this, [this, button](){handleButtonPress(button); });
-		connect(button, &QPushButton::released, this, [this, button](){handleButtonRelease(button); });
+	for (int id = 0; id < ControlKeys::count; ++id) {
+		auto button = mControlButtons[static_cast<size_t>(id)];
+		connect(button, &QPushButton::pressed, this, [this, id](){handleButtonPress(id); });
+		connect(button, &QPushButton::released, this, [this, id](){handleButtonRelease(id); });
 	}
 
+	connect(&mRepaintTimer, &QTimer::timeout, this, &GamepadForm::repaintControlButtons);
+
 	connect(connectionManager, &ConnectionManager::stateChanged, this, &GamepadForm::checkSocket);
 	connect(connectionManager, &ConnectionManager::dataWasWritten, this, &GamepadForm::checkBytesWritten);
 	connect(connectionManager, &ConnectionManager::connectionFailed, this, &GamepadForm::showConnectionFailedMessage);
-	connect(this, &GamepadForm::commandReceived, connectionManager, &ConnectionManager::write);
-
-	connect(strategy, &Strategy::commandPrepared, this, &GamepadForm::sendCommand);
+	connect(connectionManager, &ConnectionManager::linkQualityChanged, this, &GamepadForm::showLinkQuality);
+	connect(connectionManager, &ConnectionManager::peerLost, this, [this]() {
+		mUi->linkQualityLabel->setText(tr("Robot is not responding, reconnecting..."));
+	});
+	connect(connectionManager, &ConnectionManager::reconnected, this, [this](qint64 downtime) {
+		mUi->connectedLabel->setToolTip(tr("Connection restored in %1 ms").arg(downtime));
+	});
+	connect(connectionPool, &ConnectionPool::robotStateChanged, this, &GamepadForm::showRobotState);
+	connect(connectionPool, &ConnectionPool::robotLinkQualityChanged, this, &GamepadForm::showRobotLinkQuality);
+
+	// Every ConnectionManager decides itself whether to send, queue until reconnection or drop the frame
+	connect(strategyController, &StrategyController::framePrepared, connectionPool, &ConnectionPool::dispatch
+			, Qt::DirectConnection);
 	connect(qApp, &QApplication::applicationStateChanged, this, &GamepadForm::dealWithApplicationState);
 }
 
@@ -290,6 +427,21 @@ void GamepadForm::createMenu()
 	mModeMenu = new QMenu(this);
 	mMenuBar->addMenu(mModeMenu);
 
+	mRobotsMenu = new QMenu(this);
+	mMenuBar->addMenu(mRobotsMenu);
+	mAddRobotAction = new QAction(this);
+	mRobotsMenu->addAction(mAddRobotAction);
+	connect(mAddRobotAction, &QAction::triggered, this, &GamepadForm::openAddRobotDialog);
+	mRemoveRobotMenu = new QMenu(this);
+	mRobotsMenu->addMenu(mRemoveRobotMenu);
+	mRobotsMenu->addSeparator();
+	for (int i = 0; i < connectionPool->size(); ++i) {
+		if (connectionPool->contains(i)) {
+			addRobotAction(i);
+		}
+	}
+	updateRemoveRobotMenu();
+
 	mImageMenu = new QMenu(this);
 	mMenuBar->addMenu(mImageMenu);
 	mTakeImageAction = new QAction(this);
@@ -370,33 +522,62 @@ void GamepadForm::createMenu()
 void GamepadForm::setButtonsEnabled(bool enabled)
 {
 	// Here we enable or disable pads and "magic buttons" depending on given parameter.
-	for (auto &&button : controlButtonsHash.values())
+	for (auto &&button : mControlButtons)
 		button->setEnabled(enabled);
 }
 
 void GamepadForm::setButtonsCheckable(bool checkableStatus)
 {
-	for (auto &&button : controlButtonsHash.values())
+	for (auto &&button : mControlButtons)
 		button->setCheckable(checkableStatus);
 }
 
-void GamepadForm::setUpControlButtonsHash()
+void GamepadForm::setUpControlButtons()
 {
-	controlButtonsHash.insert(Qt::Key_1, mUi->button1);
-	controlButtonsHash.insert(Qt::Key_2, mUi->button2);
-	controlButtonsHash.insert(Qt::Key_3, mUi->button3);
-	controlButtonsHash.insert(Qt::Key_4, mUi->button4);
-	controlButtonsHash.insert(Qt::Key_5, mUi->button5);
+	mControlButtons[ControlKeys::digit1] = mUi->button1;
+	mControlButtons[ControlKeys::digit2] = mUi->button2;
+	mControlButtons[ControlKeys::digit3] = mUi->button3;
+	mControlButtons[ControlKeys::digit4] = mUi->button4;
+	mControlButtons[ControlKeys::digit5] = mUi->button5;
 
-	controlButtonsHash.insert(Qt::Key_A, mUi->buttonPad1Left);
-	controlButtonsHash.insert(Qt::Key_D, mUi->buttonPad1Right);
-	controlButtonsHash.insert(Qt::Key_W, mUi->buttonPad1Up);
-	controlButtonsHash.insert(Qt::Key_S, mUi->buttonPad1Down);
+	mControlButtons[ControlKeys::a] = mUi->buttonPad1Left;
+	mControlButtons[ControlKeys::d] = mUi->buttonPad1Right;
+	mControlButtons[ControlKeys::w] = mUi->buttonPad1Up;
+	mControlButtons[ControlKeys::s] = mUi->buttonPad1Down;
 
-	controlButtonsHash.insert(Qt::Key_Left, mUi->buttonPad2Left);
-	controlButtonsHash.insert(Qt::Key_Right, mUi->buttonPad2Right);
-	controlButtonsHash.insert(Qt::Key_Up, mUi->buttonPad2Up);
-	controlButtonsHash.insert(Qt::Key_Down, mUi->buttonPad2Down);
+	mControlButtons[ControlKeys::left] = mUi->buttonPad2Left;
+	mControlButtons[ControlKeys::right] = mUi->buttonPad2Right;
+	mControlButtons[ControlKeys::up] = mUi->buttonPad2Up;
+	mControlButtons[ControlKeys::down] = mUi->buttonPad2Down;
+
+	// Checked state of buttons follows keys no more often than the display can show it
+	const auto screen = QGuiApplication::primaryScreen();
+	const double refreshRate = screen && screen->refreshRate() > 0 ? screen->refreshRate() : 60.0;
+	mRepaintTimer.setSingleShot(true);
+	mRepaintTimer.setInterval(qMax(1, qRound(1000.0 / refreshRate)));
+}
+
+void GamepadForm::setUpJoystick()
+{
+	const auto &source = mSettings.value("joystickDevice").toString();
+	if (source.isEmpty()) {
+		return;
+	}
+
+	joystickInput = new JoystickInput(this);
+	joystickInput->setRate(mSettings.value("controlRate", 50).toInt());
+	joystickInput->setDeadzone(mSettings.value("joystickDeadzone", 0.1).toDouble());
+	if (!joystickInput->open(source)) {
+		qDebug() << "Joystick is not used:" << joystickInput->errorString();
+		delete joystickInput;
+		joystickInput = nullptr;
+		return;
+	}
+
+	// Sticks and buttons go through the strategy like keys, so the pad has one state and one filter
+	connect(joystickInput, &JoystickInput::inputReady, strategyController, &StrategyController::postDeviceInput
+			, Qt::DirectConnection);
+	joystickInput->start();
 }
 
 void GamepadForm::setLabels()
@@ -416,131 +597,210 @@ void GamepadForm::setLabels()
 
 void GamepadForm::setImageControl()
 {
+	// Built-in MJPEG client has decoded frame at hand, there is nothing to probe
+	if (player) {
 #ifdef TRIK_USE_QT6
-	sink = videoWidget->videoSink();
-	connect(sink, &QVideoSink::videoFrameChanged, this, &GamepadForm::saveImageToClipboard, Qt::QueuedConnection);
-	player->setVideoSink(sink);
+		sink = videoWidget->videoSink();
+		connect(sink, &QVideoSink::videoFrameChanged, this, &GamepadForm::saveImageToClipboard
+				, Qt::QueuedConnection);
+		player->setVideoSink(sink);
 #else
-	probe = new QVideoProbe(this);
-	connect(probe, &QVideoProbe::videoFrameProbed, this, &GamepadForm::saveImageToClipboard, Qt::QueuedConnection);
-	probe->setSource(player);
+		probe = new QVideoProbe(this);
+		connect(probe, &QVideoProbe::videoFrameProbed, this, &GamepadForm::saveImageToClipboard
+				, Qt::QueuedConnection);
+		probe->setSource(player);
 #endif
+	}
+
 	isFrameNecessary = false;
 	clipboard = QApplication::clipboard();
+	screenshotWorker = new ScreenshotWorker(this);
+	connect(screenshotWorker, &ScreenshotWorker::imageReady, this, &GamepadForm::setClipboardImage);
 }
 
 bool GamepadForm::eventFilter(QObject *obj, QEvent *event)
 {
 	Q_UNUSED(obj)
 
-	// Handle key press event for View
-	if(event->type() == QEvent::KeyPress) {
-		int pressedKey = (dynamic_cast<QKeyEvent *> (event))->key();
-		if (controlButtonsHash.keys().contains(pressedKey))
-			setButtonChecked(pressedKey, true);
-
-	} else if(event->type() == QEvent::KeyRelease) {
+	const auto type = event->type();
+	if (type != QEvent::KeyPress && type != QEvent::KeyRelease) {
+		return false;
+	}
 
-		QKeyEvent *keyEvent = dynamic_cast<QKeyEvent*>(event);
+	// Autorepeat and keys gamepad does not react to stop here, so a held key costs nothing after its first press
+	const auto keyEvent = static_cast<QKeyEvent *>(event);
+	const auto id = ControlKeys::idOf(keyEvent->key());
+	if (id == ControlKeys::none || keyEvent->isAutoRepeat()) {
+		return false;
+	}
 
-		auto releasedKey = keyEvent->key();
-		if (controlButtonsHash.keys().contains(releasedKey))
-			setButtonChecked(releasedKey, false);
+	const bool pressed = type == QEvent::KeyPress;
+	const auto key = ControlKeys::bit(id);
+	if (pressed == ((mHeldKeys & key) != 0)) {
+		return false;
 	}
 
+	mHeldKeys ^= key;
+	setButtonChecked(id, pressed);
+
 	// delegating events to Command-generating-strategy
-	strategy->processEvent(event);
+	strategyController->post(*keyEvent);
 
 	return false;
 }
 
-void GamepadForm::sendCommand(const QString &command)
+void GamepadForm::showRobotState(int index, QAbstractSocket::SocketState state)
+{
+	if (!mRobotActions.value(index)) {
+		return;
+	}
+
+	mRobotStates[index] = state;
+	if (state != QAbstractSocket::ConnectedState) {
+		mRobotLatencies[index] = -1;
+	}
+
+	updateRobotAction(index);
+}
+
+void GamepadForm::showRobotLinkQuality(int index, const LinkQuality &quality)
+{
+	if (!mRobotActions.value(index)) {
+		return;
+	}
+
+	mRobotLatencies[index] = quality.samples > 0 ? quality.rttP50 : -1;
+	updateRobotAction(index);
+}
+
+void GamepadForm::addRobotAction(int index)
+{
+	auto action = new QAction(this);
+	action->setCheckable(true);
+	action->setChecked(connectionPool->isSelected(index));
+	connect(action, &QAction::toggled, this, [this, index](bool checked) {
+		connectionPool->setSelected(index, checked);
+	});
+
+	// Entries are kept in index order, a robot added in place of a removed one goes before the ones after it
+	if (index >= mRobotActions.size()) {
+		mRobotActions.resize(index + 1);
+		mRobotStates.resize(index + 1);
+		mRobotLatencies.resize(index + 1);
+	}
+
+	QAction *before = nullptr;
+	for (int i = index + 1; i < mRobotActions.size() && !before; ++i) {
+		before = mRobotActions[i];
+	}
+
+	mRobotsMenu->insertAction(before, action);
+	mRobotActions[index] = action;
+	mRobotStates[index] = QAbstractSocket::UnconnectedState;
+	mRobotLatencies[index] = -1;
+	updateRobotAction(index);
+}
+
+void GamepadForm::removeRobot(int index)
 {
-	if (!connectionManager->isConnected()) {
+	if (index == 0 || !mRobotActions.value(index)) {
 		return;
 	}
 
-	Q_EMIT commandReceived(command);
+	connectionPool->removeRobot(index);
+	delete mRobotActions[index];
+	mRobotActions[index] = nullptr;
+	updateRemoveRobotMenu();
+}
+
+void GamepadForm::updateRemoveRobotMenu()
+{
+	mRemoveRobotMenu->clear();
+	for (int i = 1; i < mRobotActions.size(); ++i) {
+		if (!mRobotActions[i]) {
+			continue;
+		}
+
+		const auto &address = mSettings.value(ConnectionPool::settingsPrefix(i) + "gamepadIp").toString();
+		auto action = mRemoveRobotMenu->addAction(tr("Robot %1 (%2)").arg(i + 1).arg(address));
+
+		// The menu is rebuilt by removal, so the action must not be deleted while it is being triggered
+		connect(action, &QAction::triggered, this, [this, i]() { removeRobot(i); }, Qt::QueuedConnection);
+	}
+
+	mRemoveRobotMenu->menuAction()->setEnabled(!mRemoveRobotMenu->isEmpty());
+}
+
+void GamepadForm::updateRobotAction(int index)
+{
+	if (!mRobotActions.value(index)) {
+		return;
+	}
+
+	const auto &prefix = ConnectionPool::settingsPrefix(index);
+	const auto &address = mSettings.value(prefix + "gamepadIp", "192.168.77.1").toString();
+	QString status;
+	switch (mRobotStates[index]) {
+	case QAbstractSocket::ConnectedState:
+		status = mRobotLatencies[index] < 0
+				? tr("connected")
+				: tr("%1 ms").arg(mRobotLatencies[index], 0, 'f', 1);
+		break;
+	case QAbstractSocket::HostLookupState:
+	case QAbstractSocket::ConnectingState:
+		status = tr("connecting");
+		break;
+	default:
+		status = tr("disconnected");
+		break;
+	}
+
+	mRobotActions[index]->setText(tr("Robot %1 (%2): %3").arg(index + 1).arg(address, status));
 }
 
 void GamepadForm::changeMode(Strategies type)
 {
-	auto oldStratedy = strategy;
-	strategy = Strategy::getStrategy(type, this);
-	connect(strategy, &Strategy::commandPrepared, this, &GamepadForm::sendCommand);
-	delete oldStratedy;
+	strategyController->setStrategy(Strategy::getStrategy(type, nullptr, &mSettings));
 }
 
 void GamepadForm::dealWithApplicationState(Qt::ApplicationState state)
 {
 	if (state != Qt::ApplicationActive) {
-		strategy->reset();
-		for (auto &&button : controlButtonsHash)
-			button->setChecked(false);
+		strategyController->reset();
+		mHeldKeys = 0;
+		mCheckedKeys = 0;
+		repaintControlButtons();
 	}
 }
 
 void GamepadForm::saveImageToClipboard(QVideoFrame buffer)
 {
-	if (isFrameNecessary) {
+	// If the previous screenshot is still being made, the next frame is tried
+	if (isFrameNecessary && screenshotWorker->take(buffer)) {
 		isFrameNecessary = false;
-		QVideoFrame frame(buffer);
-#ifdef TRIK_USE_QT6
-		frame.map(QVideoFrame::ReadOnly);
-		QImage::Format imageFormat = QVideoFrameFormat::imageFormatFromPixelFormat(frame.pixelFormat());
-#else
-		frame.map(QAbstractVideoBuffer::ReadOnly);
-		QImage::Format imageFormat = QVideoFrame::imageFormatFromPixelFormat(frame.pixelFormat());
-#endif
-		QImage img;
-		// check whether videoframe can be transformed to qimage by qt
-		if (imageFormat != QImage::Format_Invalid) {
-#ifdef TRIK_USE_QT6
-			img = frame.toImage();
-#else
-			img = QImage(frame.bits(),
-						 frame.width(),
-						 frame.height(),
-						 // frame.bytesPerLine(),
-						 imageFormat);
-#endif
-		} else {
-			int width = frame.width();
-			int height = frame.height();
-			int size = height * width;
-#ifdef TRIK_USE_QT6
-			const uchar *data = frame.bits(0);
-#else
-			const uchar *data = frame.bits();
-#endif
-
-			img = QImage(width, height, QImage::Format_RGB32);
-			/// converting from yuv420 to rgb32
-			for (int i = 0; i < height; i++)
-				for (int j = 0; j < width; j++) {
-					int y = static_cast<int> (data[i * width + j]);
-					int u = static_cast<int> (data[(i / 2) * (width / 2) + (j / 2) + size]);
-					int v = static_cast<int> (data[(i / 2) * (width / 2) + (j / 2) + size + (size / 4)]);
-
-					int r = y + int(1.13983 * (v - 128));
-					int g = y - int(0.39465 * (u - 128)) - int(0.58060 * (v - 128));
-					int b = y + int(2.03211 * (u - 128));
-
-					r = qBound(0, r, 255);
-					g = qBound(0, g, 255);
-					b = qBound(0, b, 255);
-
-					img.setPixel(j, i, qRgb(r, g, b));
-				}
-		}
+	}
+}
 
-		clipboard->setImage(img);
-		frame.unmap();
+void GamepadForm::setClipboardImage(const QImage &image, const QByteArray &png)
+{
+	if (image.isNull()) {
+		return;
 	}
+
+	// Encoded PNG is handed out as is, so pasting does not encode it in GUI thread
+	auto data = new QMimeData();
+	data->setImageData(image);
+	data->setData("image/png", png);
+	clipboard->setMimeData(data);
 }
 
 void GamepadForm::requestImage()
 {
+	if (frameView) {
+		screenshotWorker->take(frameView->frame());
+		return;
+	}
+
 	isFrameNecessary = true;
 }
 
@@ -551,6 +811,35 @@ void GamepadForm::openConnectDialog()
 	mMyNewConnectForm->show();
 }
 
+void GamepadForm::openAddRobotDialog()
+{
+	const int index = connectionPool->freeIndex();
+	if (index < 0) {
+		QMessageBox::warning(this, tr("Too many robots"), tr("No more robots can be driven at once."));
+		return;
+	}
+
+	const auto &prefix = ConnectionPool::settingsPrefix(index);
+	auto form = new ConnectForm(nullptr, &mSettings, this, prefix);
+	form->setAttribute(Qt::WA_DeleteOnClose);
+	connect(form, &ConnectForm::newConnectionParameters, this, [this, index]() {
+		// Dialog may be opened twice before the first one is accepted, robot takes the next free index anyway
+		if (connectionPool->freeIndex() != index) {
+			return;
+		}
+
+		const int added = connectionPool->addRobot();
+		if (added < 0) {
+			return;
+		}
+
+		addRobotAction(added);
+		updateRemoveRobotMenu();
+		QMetaObject::invokeMethod(connectionPool->manager(added), "reconnectToHost", Qt::QueuedConnection);
+	});
+	form->show();
+}
+
 void GamepadForm::exit()
 {
 	qApp->exit();
@@ -568,28 +857,29 @@ void GamepadForm::changeEvent(QEvent *event)
 	QWidget::changeEvent(event);
 }
 
-void GamepadForm::handleButtonPress(QWidget *widget)
+void GamepadForm::handleButtonPress(int id)
 {
-	QPushButton *padButton = dynamic_cast<QPushButton *> (widget);
-	padButton->setChecked(true);
-	auto key = controlButtonsHash.key(padButton);
-	QKeyEvent keyEvent(QEvent::KeyPress, key, Qt::NoModifier);
-	strategy->processEvent(&keyEvent);
+	setButtonChecked(id, true);
+	strategyController->post(QKeyEvent(QEvent::KeyPress, ControlKeys::keyOf(id), Qt::NoModifier));
 }
 
-void GamepadForm::handleButtonRelease(QWidget *widget)
+void GamepadForm::handleButtonRelease(int id)
 {
-	QPushButton *padButton = dynamic_cast<QPushButton *> (widget);
-	padButton->setChecked(false);
-	auto key = controlButtonsHash.key(padButton);
-	QKeyEvent keyEvent(QEvent::KeyRelease, key, Qt::NoModifier);
-	strategy->processEvent(&keyEvent);
+	setButtonChecked(id, false);
+	strategyController->post(QKeyEvent(QEvent::KeyRelease, ControlKeys::keyOf(id), Qt::NoModifier));
 }
 
 void GamepadForm::retranslate()
 {
 	mConnectionMenu->setTitle(tr("&Connection"));
 	mModeMenu->setTitle(tr("&Mode"));
+	mRobotsMenu->setTitle(tr("&Robots"));
+	mAddRobotAction->setText(tr("&Add robot..."));
+	mRemoveRobotMenu->setTitle(tr("Re&move robot"));
+	updateRemoveRobotMenu();
+	for (int i = 0; i < mRobotActions.size(); ++i) {
+		updateRobotAction(i);
+	}
 	mLanguageMenu->setTitle(tr("&Language"));
 
 	mConnectAction->setText(tr("&Connect"));
@@ -30,6 +30,7 @@
 #include <QShortcut>
 #include <QMovie>
 #include <QThread>
+#include <QTimer>
 
 #ifdef TRIK_USE_QT6
 	#include <QVideoSink>
@@ -42,8 +43,15 @@
 
 #include "connectForm.h"
 
-#include "connectionManager.h"
-#include "strategy.h"
+#include "connectionPool.h"
+#include "controlKeys.h"
+#include "joystickInput.h"
+#include "mjpegStreamClient.h"
+#include "screenshotWorker.h"
+#include "strategyController.h"
+#include "videoFrameView.h"
+
+#include <array>
 
 namespace Ui {
 class GamepadForm;
@@ -67,6 +75,12 @@ public Q_SLOTS:
 	/// Slot for opening connect dialog
 	void openConnectDialog();
 
+	/// Slot for opening connect dialog for one more robot driven in formation
+	void openAddRobotDialog();
+
+	/// Disconnects the robot with given index and forgets it, robot 0 stays
+	void removeRobot(int index);
+
 	/// Slot for exit menu item
 	void exit();
 
@@ -75,11 +89,16 @@ public Q_SLOTS:
 
 private Q_SLOTS:
 
-	/// Slots for pad buttons (Up, Down, Left, Right) and "magic" buttons, triggered when button is pressed.
-	void handleButtonPress(QWidget*);
+	/// Slots for pad buttons (Up, Down, Left, Right) and "magic" buttons with given ControlKeys id,
+	/// triggered when button is pressed.
+	void handleButtonPress(int id);
 
-	/// Slots for pad buttons (Up, Down, Left, Right) and "magic" buttons, triggered when button is released.
-	void handleButtonRelease(QWidget*);
+	/// Slots for pad buttons (Up, Down, Left, Right) and "magic" buttons with given ControlKeys id,
+	/// triggered when button is released.
+	void handleButtonRelease(int id);
+
+	/// Brings checked state of control buttons in line with pressed keys, once per display refresh
+	void repaintControlButtons();
 
 	/// Slot for handle key pressing and releasing events
 	bool eventFilter(QObject *obj, QEvent *event) override;
@@ -103,18 +122,30 @@ private Q_SLOTS:
 
 	void handleMediaPlayerError(QMediaPlayer::Error error);
 
+	/// Shows state of built-in MJPEG client the same way as state of media player
+	void handleMjpegStateChanged(MjpegStreamClient::State state);
+
+	/// Shows how video frames are decoded and how late they are shown in tooltip of the video
+	void showVideoStatistics(const VideoStatistics &statistics);
+
 	void restartVideoStream();
 
 	void checkSocket(QAbstractSocket::SocketState state);
 
 	void checkBytesWritten(int result);
 
+	/// Shows round-trip time percentiles, jitter and loss next to connection indicator
+	void showLinkQuality(const LinkQuality &quality);
+
 	void showConnectionFailedMessage();
 
 	void setFontToPadButtons();
 
-	/// slot for sending command prepared by strategy to robot
-	void sendCommand(const QString &command);
+	/// Updates robot entry of robots menu when its connection state changes
+	void showRobotState(int index, QAbstractSocket::SocketState state);
+
+	/// Updates robot entry of robots menu with fresh latency
+	void showRobotLinkQuality(int index, const LinkQuality &quality);
 
 	/// slot is invoked when user presses mode actions
 	void changeMode(Strategies type);
@@ -122,25 +153,35 @@ private Q_SLOTS:
 	/// handling application state
 	void dealWithApplicationState(Qt::ApplicationState state);
 
+	/// Hands the frame over to screenshot worker if a screenshot was requested
 	void saveImageToClipboard(QVideoFrame buffer);
 	void requestImage();
 
+	/// Puts screenshot made by the worker to clipboard
+	void setClipboardImage(const QImage &image, const QByteArray &png);
+
 Q_SIGNALS:
-	/// signal to send command
-	void commandReceived(QString);
 	/// signal to disconnect from host
 	void programFinished();
 	/// Signal is emitted when connection parameters change
 	void newConnectionParameters();
 
 private:
-	void setButtonChecked(const int &key, bool checkStatus);
+	/// Marks control button with given ControlKeys id to be shown checked or not on the next display refresh
+	void setButtonChecked(int id, bool checkStatus);
 	/// Helper method that enables or disables gamepad buttons depending on connection state.
 	void setButtonsEnabled(bool enabled);
 	void setButtonsCheckable(bool checkableStatus);
-	void setUpControlButtonsHash();
+	void setUpControlButtons();
+	/// Starts joystick given by joystickDevice setting, if any
+	void setUpJoystick();
 	void setLabels();
 	void setImageControl();
+	/// Adds checkable entry for the robot with given index to robots menu
+	void addRobotAction(int index);
+	void updateRobotAction(int index);
+	/// Fills "Remove robot" submenu with every robot but robot 0
+	void updateRemoveRobotMenu();
 
 	/// Field with GUI automatically generated by gamepadForm.ui.
 	Ui::GamepadForm *mUi;
@@ -158,6 +199,17 @@ private:
 
 	QMenu *mModeMenu { nullptr }; // TODO [Doesn't have | Has] ownership
 
+	/// Robots driven in formation: "Add robot...", "Remove robot" and a checkable entry for every robot
+	QMenu *mRobotsMenu { nullptr }; // Has ownership (QObject child)
+	QAction *mAddRobotAction { nullptr }; // Has ownership (QObject child)
+	QMenu *mRemoveRobotMenu { nullptr }; // Has ownership (QObject child)
+	/// Indexed by robot, nullptr for indices of removed robots
+	QVector<QAction *> mRobotActions; // Has ownership (QObject children)
+
+	/// Last known state and median round-trip time (or -1) of every robot, shown in robots menu
+	QVector<QAbstractSocket::SocketState> mRobotStates;
+	QVector<double> mRobotLatencies;
+
 	/// Menu actions
 	QAction *mConnectAction { nullptr }; // TODO [Doesn't have | Has] ownership
 	QAction *mExitAction { nullptr }; // TODO [Doesn't have | Has] ownership
@@ -183,11 +235,24 @@ private:
 	/// For setting up translator in app
 	QTranslator *mTranslator { nullptr }; // Has ownership
 
-	/// object that encapsulates logic with commands
-	Strategy *strategy { nullptr }; // Doesn't have ownership
+	/// runs object that encapsulates logic with commands in control thread
+	StrategyController *strategyController {}; // Has ownership (QObject child)
+
+
+	/// Drives pads along with keys if joystickDevice is set
+	JoystickInput *joystickInput {}; // Has ownership (QObject child)
+
+	/// Control buttons indexed by ControlKeys id
+	std::array<QPushButton *, ControlKeys::count> mControlButtons {}; // Doesn't have ownership
 
+	/// Control keys held on keyboard, a press of a held key is autorepeat whatever the platform reports
+	ControlKeys::Mask mHeldKeys {};
 
-	QHash<int, QPushButton*> controlButtonsHash;
+	/// Control buttons to be shown checked
+	ControlKeys::Mask mCheckedKeys {};
+
+	/// Applies mCheckedKeys to buttons, runs once per display refresh at most
+	QTimer mRepaintTimer;
 
 	QShortcut *shortcut { nullptr }; // TODO [Doesn't have | Has] ownership
 	/// For changing language whem another language was chosen
@@ -196,15 +261,26 @@ private:
 	/// For catching up event when language was changed
 	void changeEvent(QEvent *event) override;
 
-	/// Class that handles network communication with TRIK.
-	ConnectionManager *connectionManager {}; // Ownership is passed to the thread
-	QThread thread;
+	/// Connections to all robots, robot 0 is the one configured by connect dialog.
+	ConnectionPool *connectionPool {}; // Has ownership (QObject child)
+	/// Class that handles network communication with robot 0.
+	ConnectionManager *connectionManager {}; // Doesn't have ownership, it is owned by connectionPool thread
 	QMediaPlayer *player { nullptr }; // TODO [Doesn't have | Has] ownership
 	QVideoWidget *videoWidget { nullptr }; // TODO [Doesn't have | Has] ownership
+
+	/// Video backend used if videoBackend setting is "mjpeg", instead of player and videoWidget
+	MjpegStreamClient *mjpegClient {}; // Has ownership (QObject child)
+	VideoFrameView *frameView {}; // Has ownership (QObject child)
+
+	/// Widget showing video, videoWidget or frameView
+	QWidget *videoView {}; // Has ownership (QObject child)
 	QMovie movie;
 
 	QClipboard *clipboard { nullptr }; //Doesn't have ownership
 
+	/// Converts and encodes screenshots in a thread pool
+	ScreenshotWorker *screenshotWorker {}; // Has ownership (QObject child)
+
 #ifdef TRIK_USE_QT6
 	QVideoSink *sink { nullptr }; // TODO [Doesn't have | Has] ownership
 #else
@@ -0,0 +1,444 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "headlessDriver.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QMetaEnum>
+#include <QtCore/QTextStream>
+#include <QtGui/QKeyEvent>
+
+#include "commandCodec.h"
+#include "inputReplay.h"
+
+#include <cstring>
+
+namespace {
+
+/// Qt key code by name like "W" or "Up", 0 if there is no such key
+int keyByName(const QByteArray &name)
+{
+	bool ok = false;
+	const int key = QMetaEnum::fromType<Qt::Key>().keyToValue(("Key_" + name).constData(), &ok);
+	return ok ? key : 0;
+}
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+}
+
+HeadlessDriver::HeadlessDriver(QObject *parent)
+	: QObject(parent)
+	, mSettings(QSettings::Format::NativeFormat, QSettings::Scope::UserScope, "CyberTech Labs"
+			, "desktop-gamepad-headless")
+{
+	mStepTimer.setSingleShot(true);
+	connect(&mStepTimer, &QTimer::timeout, this, &HeadlessDriver::runSteps);
+	connect(&mPadFilter, &PadDeltaFilter::framePrepared, this, &HeadlessDriver::onFrame);
+}
+
+HeadlessDriver::~HeadlessDriver()
+{
+	// Stops joystick and network threads before the driver they report to is gone
+	delete mJoystick;
+	delete mPool;
+}
+
+bool HeadlessDriver::isRequested(int argc, char *argv[])
+{
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--headless") == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool HeadlessDriver::start(const QStringList &arguments)
+{
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Drives TRIK robot with a script of key presses, without GUI.");
+	parser.addHelpOption();
+	parser.addOption({"headless", "Run without GUI."});
+	parser.addOption({"script", "Script file, stdin is read if omitted.", "file"});
+	parser.addOption({"joystick", "Drive pads with evdev device or replay of evemu-record dump instead of script."
+			, "source"});
+	parser.addOption({"mode", "Initial strategy: standard or accelerate. Forces the strategy for --replay."
+			, "mode", "standard"});
+	parser.addOption({"record", "Write input fed to strategies to file.", "file"});
+	parser.addOption({"replay", "Feed recorded input to strategies and print frames they emit, no robot needed."
+			, "file"});
+	parser.addOption({"fast", "Replay as fast as possible instead of real speed, frames are the same."});
+	parser.addOption({"udp", "Send pad positions over UDP."});
+	parser.addOption({"binary", "Negotiate binary protocol."});
+	parser.addOption({"drain", "Time to wait for the last replies before the report, ms.", "ms", "500"});
+	parser.addPositionalArgument("gamepadIp", "Robot address.");
+	parser.addPositionalArgument("gamepadPort", "Robot gamepad port, 4444 by default.", "[gamepadPort]");
+	if (!parser.parse(arguments)) {
+		qCritical().noquote() << parser.errorText();
+		return false;
+	}
+
+	if (parser.isSet("replay")) {
+		return startReplay(parser);
+	}
+
+	if (parser.isSet("help") || parser.positionalArguments().isEmpty()) {
+		qCritical().noquote() << parser.helpText();
+		return false;
+	}
+
+	if (parser.isSet("joystick")) {
+		mJoystick = new JoystickInput(this);
+		mJoystick->setRate(mSettings.value("controlRate", 50).toInt());
+		mJoystick->setDeadzone(mSettings.value("joystickDeadzone", 0.1).toDouble());
+		if (!mJoystick->open(parser.value("joystick"))) {
+			qCritical().noquote() << mJoystick->errorString();
+			return false;
+		}
+
+		// Input comes from joystick thread and is fed to the strategy here like script steps
+		connect(mJoystick, &JoystickInput::inputReady, this, &HeadlessDriver::onDeviceInput);
+		connect(mJoystick, &JoystickInput::finished, this, &HeadlessDriver::finish);
+	} else {
+		QFile script;
+		if (parser.isSet("script")) {
+			script.setFileName(parser.value("script"));
+			if (!script.open(QIODevice::ReadOnly | QIODevice::Text)) {
+				qCritical().noquote() << "Can not open script" << script.fileName() << ":" << script.errorString();
+				return false;
+			}
+		} else if (!script.open(stdin, QIODevice::ReadOnly | QIODevice::Text)) {
+			qCritical() << "Can not read script from stdin";
+			return false;
+		}
+
+		if (!parseScript(script.readAll())) {
+			return false;
+		}
+	}
+
+	const auto &mode = parser.value("mode");
+	if (mode != "standard" && mode != "accelerate") {
+		qCritical().noquote() << "Unknown mode" << mode;
+		return false;
+	}
+
+	if (parser.isSet("record") && !mRecorder.open(parser.value("record"))) {
+		qCritical().noquote() << mRecorder.errorString();
+		return false;
+	}
+
+	mDrainTime = parser.value("drain").toInt();
+
+	const auto &positional = parser.positionalArguments();
+	mSettings.setValue("gamepadIp", positional.at(0));
+	mSettings.setValue("gamepadPort", positional.size() < 2 ? "4444" : positional.at(1));
+	mSettings.setValue("padTransport", parser.isSet("udp") ? "udp" : "tcp");
+	mSettings.setValue("binaryProtocol", parser.isSet("binary"));
+	mPadFilter.setRefreshInterval(mSettings.value("padRefreshInterval", PadDeltaFilter::defaultRefreshInterval)
+			.toInt());
+
+	mPool = new ConnectionPool(&mSettings, this);
+	auto manager = mPool->manager(0);
+	connect(manager, &ConnectionManager::stateChanged, this, &HeadlessDriver::onStateChanged);
+	connect(manager, &ConnectionManager::dataWasWritten, this, [this](int bytes) {
+		if (bytes > 0) {
+			mBytes += bytes;
+		}
+	});
+	connect(manager, &ConnectionManager::commandsDropped, this, [this](int total) { mDropped = total; });
+	connect(manager, &ConnectionManager::reconnected, this, [this]() { ++mReconnects; });
+	connect(manager, &ConnectionManager::linkQualityChanged, this, [this](const LinkQuality &quality) {
+		mQuality = quality;
+	});
+	connect(manager, &ConnectionManager::connectionFailed, this, [this]() {
+		qCritical().noquote() << "Can not connect to" << mSettings.value("gamepadIp").toString();
+		Q_EMIT finished(1);
+	});
+
+	setStrategy(mode == "accelerate" ? Strategies::accelerateStrategy : Strategies::standartStrategy);
+	QMetaObject::invokeMethod(manager, "reconnectToHost", Qt::QueuedConnection);
+	return true;
+}
+
+bool HeadlessDriver::startReplay(const QCommandLineParser &parser)
+{
+	auto replay = new InputReplay(this);
+	if (!replay->open(parser.value("replay"))) {
+		qCritical().noquote() << replay->errorString();
+		return false;
+	}
+
+	if (parser.isSet("mode")) {
+		const auto &mode = parser.value("mode");
+		if (mode != "standard" && mode != "accelerate") {
+			qCritical().noquote() << "Unknown mode" << mode;
+			return false;
+		}
+
+		replay->forceStrategy(mode == "accelerate" ? Strategies::accelerateStrategy : Strategies::standartStrategy);
+	}
+
+	replay->setSettings(&mSettings);
+	connect(replay, &InputReplay::finished, this, [this, replay]() {
+		// Frame per line, time in ms and commands as they go to the robot in text protocol
+		const CommandCodec codec;
+		for (const auto &frame : replay->frames()) {
+			QByteArray line;
+			for (const auto &command : frame.commands) {
+				QByteArray encoded;
+				codec.encode(command, encoded);
+				if (!line.isEmpty()) {
+					line.append("; ");
+				}
+
+				line.append(encoded.trimmed());
+			}
+
+			out() << QString::number(frame.time / 1000.0, 'f', 3) << "\t" << line << "\n";
+		}
+
+		out().flush();
+		qInfo().noquote() << "Inputs:" << replay->size() << ", frames:" << replay->frames().size()
+				<< ", time in strategies:" << replay->processingTime() / qMax(replay->size(), 1) << "ns per input";
+		Q_EMIT finished(0);
+	});
+	replay->start(parser.isSet("fast"));
+	return true;
+}
+
+bool HeadlessDriver::parseScript(const QByteArray &script)
+{
+	QVector<int> openLoops;
+	const auto &lines = script.split('\n');
+	for (int lineNumber = 1; lineNumber <= lines.size(); ++lineNumber) {
+		auto line = lines[lineNumber - 1];
+		const int comment = line.indexOf('#');
+		if (comment >= 0) {
+			line.truncate(comment);
+		}
+
+		const auto &words = line.simplified().split(' ');
+		const auto &name = words[0];
+		if (name.isEmpty()) {
+			continue;
+		}
+
+		const auto fail = [lineNumber, &line]() {
+			qCritical().noquote() << "Script line" << lineNumber << "is malformed:" << line.trimmed();
+			return false;
+		};
+
+		Step step {};
+		bool ok = true;
+		if ((name == "press" || name == "release") && words.size() == 2) {
+			step.type = name == "press" ? Step::Type::press : Step::Type::release;
+			step.argument = keyByName(words[1]);
+			ok = step.argument != 0;
+		} else if (name == "tap" && words.size() == 3) {
+			step.type = Step::Type::tap;
+			step.argument = keyByName(words[1]);
+			step.duration = words[2].toInt(&ok);
+			ok = ok && step.argument != 0 && step.duration >= 0;
+		} else if (name == "wait" && words.size() == 2) {
+			step.type = Step::Type::wait;
+			step.duration = words[1].toInt(&ok);
+			ok = ok && step.duration >= 0;
+		} else if (name == "mode" && words.size() == 2 && (words[1] == "standard" || words[1] == "accelerate")) {
+			step.type = Step::Type::mode;
+			step.argument = static_cast<int>(words[1] == "accelerate"
+					? Strategies::accelerateStrategy
+					: Strategies::standartStrategy);
+		} else if (name == "repeat" && words.size() == 2) {
+			step.type = Step::Type::repeat;
+			step.duration = words[1].toInt(&ok);
+			ok = ok && step.duration > 0;
+			openLoops.append(mSteps.size());
+		} else if (name == "end" && words.size() == 1 && !openLoops.isEmpty()) {
+			step.type = Step::Type::end;
+			openLoops.removeLast();
+		} else {
+			ok = false;
+		}
+
+		if (!ok) {
+			return fail();
+		}
+
+		mSteps.append(step);
+	}
+
+	if (!openLoops.isEmpty()) {
+		qCritical() << "Script has repeat without end";
+		return false;
+	}
+
+	return true;
+}
+
+void HeadlessDriver::setStrategy(Strategies type)
+{
+	if (mStrategy) {
+		// Keys and sticks held in the old strategy must not keep pads of the robot pressed
+		for (const int key : mHeldKeys) {
+			QKeyEvent keyEvent(QEvent::KeyRelease, key, Qt::NoModifier);
+			mRecorder.recordKey(keyEvent);
+			mStrategy->processEvent(&keyEvent);
+		}
+
+		for (int pad = 1; pad <= 2; ++pad) {
+			if (mStrategy->isStickHeld(pad)) {
+				sendStick(GamepadCommand::padUp(pad));
+			}
+		}
+
+		mHeldKeys.clear();
+		mRecorder.recordReset();
+		mStrategy->reset();
+		mStrategy->deleteLater();
+	}
+
+	mStrategy = Strategy::getStrategy(type, this, &mSettings);
+	mRecorder.recordStrategy(*mStrategy);
+	mPadFilter.reset();
+	connect(mStrategy, &Strategy::framePrepared, &mPadFilter, &PadDeltaFilter::process);
+}
+
+void HeadlessDriver::sendKey(QEvent::Type type, int key)
+{
+	if (type == QEvent::KeyPress) {
+		mHeldKeys += key;
+	} else {
+		mHeldKeys -= key;
+	}
+
+	QKeyEvent keyEvent(type, key, Qt::NoModifier);
+	mRecorder.recordKey(keyEvent);
+	mStrategy->processEvent(&keyEvent);
+}
+
+void HeadlessDriver::sendStick(const GamepadCommand &command)
+{
+	mRecorder.recordStick(command);
+	mStrategy->processStick(command);
+}
+
+void HeadlessDriver::onDeviceInput(const InputEvent &event)
+{
+	if (event.kind == InputEvent::Kind::stick) {
+		sendStick(event.stick);
+	} else if (event.kind == InputEvent::Kind::key) {
+		sendKey(event.type, event.key);
+	}
+}
+
+void HeadlessDriver::onStateChanged(QAbstractSocket::SocketState state)
+{
+	if (state == QAbstractSocket::ConnectedState && !mStarted) {
+		mStarted = true;
+		mClock.start();
+		if (mJoystick) {
+			mJoystick->start();
+		} else {
+			runSteps();
+		}
+	}
+}
+
+void HeadlessDriver::onFrame(const CommandFrame &frame)
+{
+	++mFrames;
+	mCommands += frame.size();
+	mPool->dispatch(frame);
+}
+
+void HeadlessDriver::runSteps()
+{
+	// Tap pauses with the key held, so the pause ends with its release
+	if (mCurrentStep > 0 && mSteps[mCurrentStep - 1].type == Step::Type::tap) {
+		sendKey(QEvent::KeyRelease, mSteps[mCurrentStep - 1].argument);
+	}
+
+	while (mCurrentStep < mSteps.size()) {
+		const auto &step = mSteps[mCurrentStep++];
+		switch (step.type) {
+		case Step::Type::press:
+			sendKey(QEvent::KeyPress, step.argument);
+			break;
+		case Step::Type::release:
+			sendKey(QEvent::KeyRelease, step.argument);
+			break;
+		case Step::Type::tap:
+			sendKey(QEvent::KeyPress, step.argument);
+			mStepTimer.start(step.duration);
+			return;
+		case Step::Type::wait:
+			mStepTimer.start(step.duration);
+			return;
+		case Step::Type::mode:
+			setStrategy(static_cast<Strategies>(step.argument));
+			break;
+		case Step::Type::repeat:
+			mLoops.append({mCurrentStep, step.duration});
+			break;
+		case Step::Type::end:
+			if (--mLoops.last().remaining > 0) {
+				mCurrentStep = mLoops.last().begin;
+			} else {
+				mLoops.removeLast();
+			}
+
+			break;
+		}
+	}
+
+	finish();
+}
+
+void HeadlessDriver::finish()
+{
+	// Leaves the robot standing still whatever the script did
+	setStrategy(Strategies::standartStrategy);
+	QTimer::singleShot(mDrainTime, this, [this]() {
+		printReport();
+		Q_EMIT finished(0);
+	});
+}
+
+void HeadlessDriver::printReport() const
+{
+	const double seconds = qMax(mClock.elapsed(), qint64(1)) / 1000.0;
+	out() << "Duration: " << seconds << " s" << "\n";
+	out() << "Frames: " << mFrames << ", commands: " << mCommands << ", bytes written: " << mBytes << "\n";
+	out() << "Throughput: " << mCommands / seconds << " commands/s, " << mBytes / seconds << " bytes/s" << "\n";
+	out() << "Pad commands sent: " << mPadFilter.sentPads() << ", not sent as unchanged: "
+			<< mPadFilter.suppressedPads() << "\n";
+	out() << "Commands dropped in send queue: " << mDropped << ", reconnections: " << mReconnects << "\n";
+	if (mQuality.samples > 0) {
+		out() << "RTT p50/p95/p99: " << mQuality.rttP50 << "/" << mQuality.rttP95 << "/" << mQuality.rttP99
+				<< " ms, jitter: " << mQuality.jitter << " ms, loss: " << mQuality.loss * 100 << "%" << "\n";
+	} else {
+		out() << "RTT: robot does not speak binary protocol or answer pings" << "\n";
+	}
+
+	out().flush();
+}
@@ -0,0 +1,148 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QSettings>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+#include <QtCore/QSet>
+
+#include "connectionPool.h"
+#include "inputRecorder.h"
+#include "joystickInput.h"
+#include "padDeltaFilter.h"
+#include "strategy.h"
+
+class QCommandLineParser;
+
+/// Drives a robot without GUI: key presses are read from a script and fed to the same strategies and connection
+/// code the gamepad window uses. Meant for soak tests and automated drives on machines without display.
+/// Script is read from a file or stdin, one step per line, '#' starts a comment:
+/// * press <key> / release <key> --- key as named in Qt::Key without "Key_" prefix: W, Up, 1;
+/// * tap <key> <ms> --- press key, hold it for given time and release;
+/// * wait <ms> --- pause;
+/// * mode standard|accelerate --- switch strategy, held keys are released;
+/// * repeat <count> ... end --- run enclosed steps given number of times, may be nested.
+/// Throughput and latency summary is printed to stdout when the script ends.
+/// With --record option input fed to strategies is written to a file, --replay feeds such a file to strategies
+/// without a robot and prints frames they emit, one per line, so two runs can be diffed.
+/// With --joystick option a joystick or an evemu-record dump is fed to strategies instead of a script.
+/// Benchmarks are not here, they are built into gamepadBench of the tests project.
+class HeadlessDriver : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(HeadlessDriver)
+
+public:
+	/// Creates driver, connection settings are kept apart from the gamepad window ones
+	explicit HeadlessDriver(QObject *parent = nullptr);
+	~HeadlessDriver() override;
+
+	/// Returns true if command line asks for headless mode, must be checked before any application is created
+	static bool isRequested(int argc, char *argv[]);
+
+	/// Parses command line and script and starts connecting. Returns false and prints the reason if they are wrong.
+	bool start(const QStringList &arguments);
+
+signals:
+	/// Emitted when the script is over or connection failed, with process exit code
+	void finished(int exitCode);
+
+private slots:
+	/// Runs script steps up to the next pause
+	void runSteps();
+
+	void onStateChanged(QAbstractSocket::SocketState state);
+	void onFrame(const CommandFrame &frame);
+
+	/// Feeds joystick stick or button to the strategy
+	void onDeviceInput(const InputEvent &event);
+
+private:
+	/// One line of the script
+	struct Step {
+		enum class Type {
+			press
+			, release
+			, tap
+			, wait
+			, mode
+			, repeat
+			, end
+		};
+
+		Type type;
+
+		/// Key code or strategy
+		int argument {};
+
+		/// Pause in ms or repeat count
+		int duration {};
+	};
+
+	/// Currently running repeat block
+	struct Loop {
+		int begin;
+		int remaining;
+	};
+
+	bool parseScript(const QByteArray &script);
+
+	/// Starts --replay run, returns false and prints the reason if the recording can not be read
+	bool startReplay(const QCommandLineParser &parser);
+
+	void setStrategy(Strategies type);
+	void sendKey(QEvent::Type type, int key);
+	void sendStick(const GamepadCommand &command);
+	void finish();
+	void printReport() const;
+
+	/// Settings of headless connection, so a script never overwrites the robot chosen in the gamepad window
+	QSettings mSettings;
+
+	ConnectionPool *mPool {}; // Has ownership (QObject child)
+	Strategy *mStrategy {}; // Has ownership (QObject child)
+
+	/// Frames of the strategy pass it on their way to the pool
+	PadDeltaFilter mPadFilter;
+
+	/// Replaces the script if set
+	JoystickInput *mJoystick {}; // Has ownership (QObject child)
+
+	/// Writes input fed to strategies if --record is given
+	InputRecorder mRecorder;
+
+	QVector<Step> mSteps;
+	QVector<Loop> mLoops;
+	QSet<int> mHeldKeys;
+	int mCurrentStep {};
+	bool mStarted {};
+
+	/// Fires when current pause is over
+	QTimer mStepTimer;
+
+	/// Time to let the last commands and echoes arrive before the report, in ms
+	int mDrainTime { 500 };
+
+	QElapsedTimer mClock;
+	qint64 mFrames {};
+	qint64 mCommands {};
+	qint64 mBytes {};
+	int mDropped {};
+	int mReconnects {};
+	LinkQuality mQuality;
+};
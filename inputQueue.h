@@ -0,0 +1,90 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QEvent>
+#include <QtCore/QMetaType>
+
+#include <array>
+#include <atomic>
+
+#include "gamepadCommand.h"
+
+/// Input for a strategy: key event, reset of all pressed keys or analog stick position
+struct InputEvent {
+	enum class Kind : quint8 {
+		key
+		, reset
+		, stick ///< see Strategy::processStick()
+	};
+
+	Kind kind { Kind::key };
+	bool autoRepeat {};
+	QEvent::Type type { QEvent::None };
+	int key {};
+
+	/// Pad or padUp command of the pad moved by the stick
+	GamepadCommand stick;
+
+	/// Order of the event among input of all threads, stamped by StrategyController when the event is queued
+	quint64 sequence {};
+};
+
+Q_DECLARE_METATYPE(InputEvent)
+
+/// Bounded lock-free queue of input events with one producer thread and one consumer thread. Neither side ever
+/// blocks or allocates: producer fails to push when the queue is full, consumer fails to pop when it is empty.
+class InputQueue
+{
+public:
+	/// Maximal number of queued events plus one, power of two
+	static constexpr unsigned capacity = 256;
+
+	/// Appends event, returns false if the queue is full. Producer thread only.
+	bool push(const InputEvent &event)
+	{
+		const auto tail = mTail.load(std::memory_order_relaxed);
+		const auto next = (tail + 1) & (capacity - 1);
+		if (next == mHead.load(std::memory_order_acquire)) {
+			return false;
+		}
+
+		mEvents[tail] = event;
+		mTail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/// Takes the oldest event, returns false if the queue is empty. Consumer thread only.
+	bool pop(InputEvent &event)
+	{
+		const auto head = mHead.load(std::memory_order_relaxed);
+		if (head == mTail.load(std::memory_order_acquire)) {
+			return false;
+		}
+
+		event = mEvents[head];
+		mHead.store((head + 1) & (capacity - 1), std::memory_order_release);
+		return true;
+	}
+
+private:
+	std::array<InputEvent, capacity> mEvents {};
+
+	/// Index of the oldest event, written by consumer only
+	std::atomic<unsigned> mHead { 0 };
+
+	/// Index of the slot for the next event, written by producer only
+	std::atomic<unsigned> mTail { 0 };
+};
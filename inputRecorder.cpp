@@ -0,0 +1,184 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "inputRecorder.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QtEndian>
+
+#include "accelerateStrategy.h"
+#include "controlKeys.h"
+
+namespace {
+
+const char magic[] = "TGIR";
+constexpr int magicSize = 4;
+constexpr quint8 version = 1;
+constexpr int recordSize = 8;
+
+/// Flags byte: kind in the low bits, then key event details. Release flag of a stick stands for padUp.
+constexpr quint8 kindMask = 0x03;
+constexpr quint8 releaseFlag = 0x04;
+constexpr quint8 autoRepeatFlag = 0x08;
+
+}
+
+bool InputRecorder::open(const QString &path)
+{
+	mFile.setFileName(path);
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		mError = QString("Can not write input recording %1: %2").arg(path, mFile.errorString());
+		return false;
+	}
+
+	mFile.write(magic, magicSize);
+	mFile.putChar(static_cast<char>(version));
+	mLastTime = 0;
+	mClock.start();
+	return true;
+}
+
+bool InputRecorder::isOpen() const
+{
+	return mFile.isOpen();
+}
+
+QString InputRecorder::errorString() const
+{
+	return mError;
+}
+
+void InputRecorder::recordKey(const QKeyEvent &event)
+{
+	const auto id = ControlKeys::idOf(event.key());
+	if (id == ControlKeys::none) {
+		return;
+	}
+
+	quint8 flags = event.type() == QEvent::KeyRelease ? releaseFlag : 0;
+	if (event.isAutoRepeat()) {
+		flags |= autoRepeatFlag;
+	}
+
+	write(RecordedInput::Kind::key, flags, id);
+}
+
+void InputRecorder::recordReset()
+{
+	write(RecordedInput::Kind::reset, 0, 0);
+}
+
+void InputRecorder::recordStrategy(const Strategy &strategy)
+{
+	const auto type = qobject_cast<const AccelerateStrategy *>(&strategy)
+			? Strategies::accelerateStrategy
+			: Strategies::standartStrategy;
+	write(RecordedInput::Kind::strategy, 0, static_cast<int>(type));
+}
+
+void InputRecorder::recordStick(const GamepadCommand &command)
+{
+	const bool isPad = command.type == GamepadCommand::Type::pad;
+	write(RecordedInput::Kind::stick, isPad ? 0 : releaseFlag, command.id, command.x, command.y);
+}
+
+void InputRecorder::write(RecordedInput::Kind kind, quint8 flags, int argument, int x, int y)
+{
+	if (!mFile.isOpen()) {
+		return;
+	}
+
+	// Pauses longer than 71 minutes do not fit and are shortened, nothing happens during them anyway
+	const qint64 now = mClock.nsecsElapsed() / 1000;
+	const auto delta = static_cast<quint32>(qMin<qint64>(now - mLastTime, 0xffffffffLL));
+	mLastTime = now;
+
+	uchar record[recordSize];
+	qToLittleEndian(delta, record);
+	record[4] = static_cast<uchar>(static_cast<quint8>(kind) | flags);
+	record[5] = static_cast<uchar>(argument);
+	record[6] = static_cast<uchar>(x);
+	record[7] = static_cast<uchar>(y);
+	if (mFile.write(reinterpret_cast<const char *>(record), recordSize) != recordSize) {
+		qWarning().noquote() << "Input recording stopped:" << mFile.errorString();
+		mFile.close();
+	}
+}
+
+bool InputRecorder::load(const QString &path, QVector<RecordedInput> &records, QString &error)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		error = QString("Can not read input recording %1: %2").arg(path, file.errorString());
+		return false;
+	}
+
+	const auto &data = file.readAll();
+	if (data.size() < magicSize + 1 || !data.startsWith(magic) || static_cast<quint8>(data[magicSize]) != version
+			|| (data.size() - magicSize - 1) % recordSize != 0) {
+		error = QString("%1 is not an input recording of this version").arg(path);
+		return false;
+	}
+
+	records.clear();
+	records.reserve((data.size() - magicSize - 1) / recordSize);
+	qint64 time = 0;
+	for (int offset = magicSize + 1; offset < data.size(); offset += recordSize) {
+		const auto record = reinterpret_cast<const uchar *>(data.constData() + offset);
+		time += qFromLittleEndian<quint32>(record);
+
+		RecordedInput input;
+		input.time = time;
+		input.kind = static_cast<RecordedInput::Kind>(record[4] & kindMask);
+		switch (input.kind) {
+		case RecordedInput::Kind::key:
+			if (record[5] >= ControlKeys::count) {
+				error = QString("%1 has unknown key at offset %2").arg(path).arg(offset);
+				return false;
+			}
+
+			input.type = (record[4] & releaseFlag) ? QEvent::KeyRelease : QEvent::KeyPress;
+			input.autoRepeat = (record[4] & autoRepeatFlag) != 0;
+			input.argument = ControlKeys::keyOf(record[5]);
+			break;
+		case RecordedInput::Kind::reset:
+			break;
+		case RecordedInput::Kind::strategy:
+			if (record[5] >= static_cast<int>(Strategies::TOTAL)) {
+				error = QString("%1 has unknown strategy at offset %2").arg(path).arg(offset);
+				return false;
+			}
+
+			input.argument = record[5];
+			break;
+		case RecordedInput::Kind::stick:
+			if (record[5] < 1 || record[5] > 2) {
+				error = QString("%1 has unknown stick at offset %2").arg(path).arg(offset);
+				return false;
+			}
+
+			input.stick = (record[4] & releaseFlag)
+					? GamepadCommand::padUp(record[5])
+					: GamepadCommand::pad(record[5], static_cast<qint8>(record[6]), static_cast<qint8>(record[7]));
+			break;
+		default:
+			error = QString("%1 has unknown record at offset %2").arg(path).arg(offset);
+			return false;
+		}
+
+		records.append(input);
+	}
+
+	return true;
+}
@@ -0,0 +1,93 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QVector>
+#include <QtGui/QKeyEvent>
+
+#include "gamepadCommand.h"
+
+class Strategy;
+
+/// Input fed to a strategy, as stored in a recording
+struct RecordedInput {
+	enum class Kind : quint8 {
+		key
+		, reset ///< Strategy::reset() call
+		, strategy ///< switch to another strategy
+		, stick ///< Strategy::processStick() call
+	};
+
+	/// Time since recording started, in microseconds
+	qint64 time {};
+
+	Kind kind { Kind::key };
+	QEvent::Type type { QEvent::None };
+	bool autoRepeat {};
+
+	/// Qt key or Strategies value
+	int argument {};
+
+	/// Command of the stick
+	GamepadCommand stick;
+};
+
+/// Writes every input fed to a strategy into a compact binary file with monotonic timestamps, so a live session
+/// can be replayed later by InputReplay. File starts with "TGIR" and format version byte, 8-byte records follow:
+/// time since the previous record in microseconds as 32-bit little endian number, kind and flags byte,
+/// ControlKeys id, Strategies value or pad number, then stick coordinates as two signed bytes. Keys gamepad does not
+/// react to are not recorded. Not thread-safe, meant to be used by the thread which feeds the strategy.
+class InputRecorder
+{
+	Q_DISABLE_COPY(InputRecorder)
+
+public:
+	InputRecorder() = default;
+
+	/// Creates or truncates the file and starts the clock. Returns false if the file can not be written,
+	/// see errorString().
+	bool open(const QString &path);
+
+	/// Returns true if the recording is being written
+	bool isOpen() const;
+
+	/// Description of the last error
+	QString errorString() const;
+
+	/// Records key event, does nothing if the recording is not open
+	void recordKey(const QKeyEvent &event);
+
+	/// Records reset of pressed keys, does nothing if the recording is not open
+	void recordReset();
+
+	/// Records switch to given strategy, does nothing if the recording is not open
+	void recordStrategy(const Strategy &strategy);
+
+	/// Records pad or padUp command of a stick, does nothing if the recording is not open
+	void recordStick(const GamepadCommand &command);
+
+	/// Reads recording into records. Returns false and fills error if the file can not be read or is malformed.
+	static bool load(const QString &path, QVector<RecordedInput> &records, QString &error);
+
+private:
+	void write(RecordedInput::Kind kind, quint8 flags, int argument, int x = 0, int y = 0);
+
+	QFile mFile;
+	QElapsedTimer mClock;
+	qint64 mLastTime {};
+	QString mError;
+};
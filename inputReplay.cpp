@@ -0,0 +1,166 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "inputReplay.h"
+
+#include <QtGui/QKeyEvent>
+
+constexpr int InputReplay::tailTime;
+
+InputReplay::InputReplay(QObject *parent)
+	: QObject(parent)
+	, mTimer(this)
+{
+	mTimer.setSingleShot(true);
+	mTimer.setTimerType(Qt::PreciseTimer);
+	connect(&mTimer, &QTimer::timeout, this, &InputReplay::feed);
+}
+
+bool InputReplay::open(const QString &path)
+{
+	return InputRecorder::load(path, mRecords, mError);
+}
+
+QString InputReplay::errorString() const
+{
+	return mError;
+}
+
+int InputReplay::size() const
+{
+	return mRecords.size();
+}
+
+void InputReplay::forceStrategy(Strategies type)
+{
+	mForced = true;
+	mForcedType = type;
+}
+
+void InputReplay::setSettings(const QSettings *settings)
+{
+	mSettings = settings;
+}
+
+void InputReplay::start(bool asFastAsPossible)
+{
+	mNext = 0;
+	mFrames.clear();
+	mProcessingTime = 0;
+	mStrategyStart = 0;
+	setStrategy(mForced ? mForcedType : Strategies::standartStrategy);
+	mClock.start();
+	if (asFastAsPossible) {
+		// Asynchronous anyway, so finished() never comes before start() returns
+		QTimer::singleShot(0, this, [this]() {
+			while (mNext < mRecords.size()) {
+				apply(mRecords[mNext++]);
+			}
+
+			finish();
+		});
+	} else {
+		feed();
+	}
+}
+
+const QVector<InputReplay::Frame> &InputReplay::frames() const
+{
+	return mFrames;
+}
+
+qint64 InputReplay::processingTime() const
+{
+	return mProcessingTime;
+}
+
+void InputReplay::feed()
+{
+	const qint64 now = mClock.nsecsElapsed() / 1000;
+	while (mNext < mRecords.size() && mRecords[mNext].time <= now) {
+		apply(mRecords[mNext++]);
+	}
+
+	if (mNext < mRecords.size()) {
+		// Timeout is recomputed from the clock every time, so delays of the event loop do not add up
+		mTimer.start(static_cast<int>((mRecords[mNext].time - now + 999) / 1000));
+	} else {
+		QTimer::singleShot(tailTime, this, &InputReplay::finish);
+	}
+}
+
+void InputReplay::advanceTo(qint64 time)
+{
+	QElapsedTimer timer;
+	timer.start();
+	mStrategy->advanceClock(qMax<qint64>(0, time - mStrategyStart - mStrategy->virtualTime()));
+	mProcessingTime += timer.nsecsElapsed();
+}
+
+void InputReplay::apply(const RecordedInput &input)
+{
+	advanceTo(input.time);
+	QElapsedTimer timer;
+	timer.start();
+	switch (input.kind) {
+	case RecordedInput::Kind::key: {
+		QKeyEvent event(input.type, input.argument, Qt::NoModifier, QString(), input.autoRepeat);
+		mStrategy->processEvent(&event);
+		break;
+	}
+	case RecordedInput::Kind::reset:
+		mStrategy->reset();
+		break;
+	case RecordedInput::Kind::stick:
+		mStrategy->processStick(input.stick);
+		break;
+	case RecordedInput::Kind::strategy:
+		if (!mForced) {
+			setStrategy(static_cast<Strategies>(input.argument));
+		}
+
+		break;
+	}
+
+	mProcessingTime += timer.nsecsElapsed();
+}
+
+void InputReplay::setStrategy(Strategies type)
+{
+	if (mStrategy) {
+		mStrategyStart += mStrategy->virtualTime();
+		delete mStrategy;
+	}
+
+	mStrategy = Strategy::getStrategy(type, this, mSettings);
+	mStrategy->setVirtualClock(true);
+	connect(mStrategy, &Strategy::framePrepared, this, &InputReplay::capture);
+}
+
+void InputReplay::capture(const CommandFrame &frame)
+{
+	mFrames.append({mStrategyStart + mStrategy->virtualTime(), frame});
+}
+
+void InputReplay::finish()
+{
+	if (!mRecords.isEmpty()) {
+		advanceTo(mRecords.last().time + tailTime * 1000LL);
+	}
+
+	// Nothing emitted after the replay is over gets into the result
+	delete mStrategy;
+	mStrategy = nullptr;
+	Q_EMIT finished();
+}
@@ -0,0 +1,108 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include "inputRecorder.h"
+#include "strategy.h"
+
+class QSettings;
+
+/// Feeds input recorded by InputRecorder to strategies and captures frames they emit, so strategy changes can be
+/// checked against real sessions and timed on them. Strategy switches of the recording are followed unless
+/// a strategy is forced.
+/// Strategies run on a virtual clock moved along the recorded timeline, so control ticks and stop timers of
+/// AccelerateStrategy fire at the same virtual times on every run and the result can be diffed. At real speed input
+/// is paced as it was recorded, as fast as possible it is fed back to back, frames are the same either way.
+class InputReplay : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(InputReplay)
+
+public:
+	/// Frame emitted by a strategy
+	struct Frame {
+		/// Virtual time since replay start in microseconds
+		qint64 time;
+
+		CommandFrame commands;
+	};
+
+	/// Time the last strategy keeps running after the last input, to capture pads going down, in ms
+	static constexpr int tailTime = 1000;
+
+	explicit InputReplay(QObject *parent = nullptr);
+
+	/// Reads recording, returns false if it can not be read, see errorString()
+	bool open(const QString &path);
+
+	/// Description of the last error
+	QString errorString() const;
+
+	/// Number of recorded inputs
+	int size() const;
+
+	/// Replays everything into given strategy, ignoring strategy switches of the recording
+	void forceStrategy(Strategies type);
+
+	/// Settings strategies are created with, shall outlive the replay
+	void setSettings(const QSettings *settings);
+
+	/// Starts replay, finished() is emitted when it is over
+	void start(bool asFastAsPossible);
+
+	/// Frames captured so far
+	const QVector<Frame> &frames() const;
+
+	/// Time spent in strategies handling input and their timers, in nanoseconds
+	qint64 processingTime() const;
+
+signals:
+	void finished();
+
+private:
+	/// Feeds input which is due, schedules the next one
+	void feed();
+
+	/// Moves virtual clock of the strategy to given time since replay start, in microseconds
+	void advanceTo(qint64 time);
+
+	void apply(const RecordedInput &input);
+	void setStrategy(Strategies type);
+	void capture(const CommandFrame &frame);
+	void finish();
+
+	QVector<RecordedInput> mRecords;
+	int mNext {};
+	QString mError;
+
+	Strategy *mStrategy {}; // Has ownership (QObject child)
+	const QSettings *mSettings {}; // Doesn't have ownership
+	bool mForced {};
+	Strategies mForcedType { Strategies::standartStrategy };
+
+	QTimer mTimer;
+	QElapsedTimer mClock;
+
+	/// Virtual time the current strategy was created at, its clock starts from 0 there
+	qint64 mStrategyStart {};
+
+	qint64 mProcessingTime {};
+	QVector<Frame> mFrames;
+};
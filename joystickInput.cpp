@@ -0,0 +1,457 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "joystickInput.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include <array>
+#include <cmath>
+
+#include "controlKeys.h"
+#include "controlScheduler.h"
+
+#ifdef Q_OS_LINUX
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <linux/input.h>
+	#include <sys/ioctl.h>
+	#include <unistd.h>
+#endif
+
+namespace {
+
+/// Event types and codes of evdev used here, the same numbers are used by evemu-record dumps on any platform
+constexpr int evKey = 0x01;
+constexpr int evAbs = 0x03;
+
+/// Axes in the order X1, Y1, X2, Y2: left stick moves pad 1, right stick moves pad 2
+constexpr int axisCount = 4;
+constexpr int axisCodes[axisCount] = { 0x00, 0x01, 0x03, 0x04 }; // ABS_X, ABS_Y, ABS_RX, ABS_RY
+
+/// Joystick buttons acting as magic buttons, by number of the magic button
+constexpr int buttonCount = 5;
+constexpr int buttonCodes[buttonCount] = { 0x130, 0x131, 0x133, 0x134, 0x136 }; // BTN_SOUTH, EAST, NORTH, WEST, TL
+
+#ifdef Q_OS_LINUX
+static_assert(evKey == EV_KEY && evAbs == EV_ABS, "evdev event types differ");
+static_assert(axisCodes[0] == ABS_X && axisCodes[1] == ABS_Y && axisCodes[2] == ABS_RX && axisCodes[3] == ABS_RY
+		, "evdev axis codes differ");
+static_assert(buttonCodes[0] == BTN_SOUTH && buttonCodes[4] == BTN_TL, "evdev button codes differ");
+#endif
+
+/// Index of element equal to value, -1 if there is none
+template <size_t size>
+int indexOf(const int (&codes)[size], int value)
+{
+	for (size_t i = 0; i < size; ++i) {
+		if (codes[i] == value) {
+			return static_cast<int>(i);
+		}
+	}
+
+	return -1;
+}
+
+}
+
+/// Works in background thread of JoystickInput: reads events, keeps stick and button state and samples it
+class JoystickReader : public QObject
+{
+public:
+	/// Input event with time from the beginning of a dump, in microseconds
+	struct Event {
+		qint64 time;
+		int type;
+		int code;
+		int value;
+	};
+
+	/// Range of an axis as reported by the device
+	struct AxisRange {
+		int minimum { -32768 };
+		int maximum { 32767 };
+		int flat {};
+	};
+
+	explicit JoystickReader(JoystickInput *input)
+		: mInput(input)
+	{
+		centerSticks();
+	}
+
+	~JoystickReader() override
+	{
+#ifdef Q_OS_LINUX
+		if (mDevice >= 0) {
+			::close(mDevice);
+		}
+#endif
+	}
+
+	bool openDevice(const QString &path, QString &error);
+	bool openDump(const QString &path, QString &error);
+
+	/// Starts sampling and reading, called in background thread
+	void run();
+
+	int rate { 50 };
+	double deadzone { 0.1 };
+
+private:
+	void readDevice();
+	void replay();
+	void apply(const Event &event);
+	void sample();
+
+	/// Releases sticks and buttons, emits their releases and stops sampling
+	void stop();
+
+	void post(const InputEvent &event);
+
+	void centerSticks();
+
+	/// Position of the axis from -1 to 1
+	double normalized(int axis) const;
+
+	JoystickInput *mInput; // Doesn't have ownership
+
+	std::array<AxisRange, axisCount> mRanges {};
+	std::array<int, axisCount> mValues {};
+
+	/// Last emitted command of every stick, the same one is not emitted again
+	std::array<GamepadCommand, 2> mSticks {};
+
+	/// Pressed magic buttons, those pressed since the last sample and those emitted as pressed,
+	/// bit n is button n + 1
+	unsigned mPressedButtons {};
+	unsigned mNewButtons {};
+	unsigned mPostedButtons {};
+
+	int mDevice { -1 };
+	QSocketNotifier *mNotifier {}; // Has ownership (QObject child)
+
+	QVector<Event> mDump;
+	int mDumpPosition {};
+	QElapsedTimer mReplayClock;
+	QTimer *mReplayTimer {}; // Has ownership (QObject child)
+
+	QTimer *mSampleTimer {}; // Has ownership (QObject child)
+};
+
+bool JoystickReader::openDevice(const QString &path, QString &error)
+{
+#ifdef Q_OS_LINUX
+	mDevice = ::open(path.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (mDevice < 0) {
+		error = QString("Can not open %1: %2").arg(path, qt_error_string(errno));
+		return false;
+	}
+
+	for (int axis = 0; axis < axisCount; ++axis) {
+		input_absinfo info {};
+		if (::ioctl(mDevice, EVIOCGABS(axisCodes[axis]), &info) == 0 && info.maximum > info.minimum) {
+			mRanges[static_cast<size_t>(axis)] = { info.minimum, info.maximum, info.flat };
+		}
+	}
+
+	centerSticks();
+	return true;
+#else
+	error = QString("Can not open %1: evdev devices are available on Linux only").arg(path);
+	return false;
+#endif
+}
+
+bool JoystickReader::openDump(const QString &path, QString &error)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		error = QString("Can not open %1: %2").arg(path, file.errorString());
+		return false;
+	}
+
+	// evemu-record format: "A: <code> <min> <max> <fuzz> <flat> <resolution>" describes an axis,
+	// "E: <seconds>.<microseconds> <type> <code> <value>" is an event, type and code are hexadecimal
+	qint64 start = -1;
+	while (!file.atEnd()) {
+		auto line = file.readLine();
+		const int comment = line.indexOf('#');
+		if (comment >= 0) {
+			line.truncate(comment);
+		}
+
+		const auto &fields = line.simplified().split(' ');
+		bool ok = true;
+		if (fields.size() >= 6 && fields[0] == "A:") {
+			const int axis = indexOf(axisCodes, fields[1].toInt(&ok, 16));
+			if (ok && axis >= 0) {
+				mRanges[static_cast<size_t>(axis)] = { fields[2].toInt(), fields[3].toInt(), fields[5].toInt() };
+			}
+		} else if (fields.size() >= 5 && fields[0] == "E:") {
+			const auto &time = fields[1].split('.');
+			const qint64 seconds = time[0].toLongLong(&ok);
+			const qint64 microseconds = time.size() > 1 ? time[1].toLongLong() : 0;
+			const Event event {
+				seconds * 1000000 + microseconds
+				, fields[2].toInt(nullptr, 16)
+				, fields[3].toInt(nullptr, 16)
+				, fields[4].toInt()
+			};
+
+			if (ok) {
+				if (start < 0) {
+					start = event.time;
+				}
+
+				mDump.append({ event.time - start, event.type, event.code, event.value });
+			}
+		}
+	}
+
+	if (mDump.isEmpty()) {
+		error = QString("%1 has no evemu-record events").arg(path);
+		return false;
+	}
+
+	centerSticks();
+	return true;
+}
+
+void JoystickReader::run()
+{
+	mSampleTimer = new QTimer(this);
+	mSampleTimer->setTimerType(Qt::PreciseTimer);
+	connect(mSampleTimer, &QTimer::timeout, this, [this]() { sample(); });
+	mSampleTimer->start(1000 / rate);
+
+	if (mDevice >= 0) {
+		mNotifier = new QSocketNotifier(mDevice, QSocketNotifier::Read, this);
+		connect(mNotifier, &QSocketNotifier::activated, this, [this]() { readDevice(); });
+	} else {
+		mReplayTimer = new QTimer(this);
+		mReplayTimer->setSingleShot(true);
+		mReplayTimer->setTimerType(Qt::PreciseTimer);
+		connect(mReplayTimer, &QTimer::timeout, this, [this]() { replay(); });
+		mReplayClock.start();
+		replay();
+	}
+}
+
+void JoystickReader::readDevice()
+{
+#ifdef Q_OS_LINUX
+	input_event events[64];
+	for (;;) {
+		const auto bytes = ::read(mDevice, events, sizeof(events));
+		if (bytes < 0 && errno == EAGAIN) {
+			return;
+		}
+
+		if (bytes <= 0) {
+			// Device is unplugged, the robot shall not keep moving
+			qWarning().noquote() << "Joystick is lost:" << qt_error_string(errno);
+			mNotifier->setEnabled(false);
+			stop();
+			return;
+		}
+
+		const auto count = static_cast<size_t>(bytes) / sizeof(input_event);
+		for (size_t i = 0; i < count; ++i) {
+			apply({ 0, events[i].type, events[i].code, events[i].value });
+		}
+	}
+#endif
+}
+
+void JoystickReader::replay()
+{
+	const qint64 now = mReplayClock.nsecsElapsed() / 1000;
+	while (mDumpPosition < mDump.size() && mDump[mDumpPosition].time <= now) {
+		apply(mDump[mDumpPosition++]);
+	}
+
+	if (mDumpPosition < mDump.size()) {
+		mReplayTimer->start(static_cast<int>((mDump[mDumpPosition].time - now) / 1000));
+		return;
+	}
+
+	stop();
+	auto input = mInput;
+	QMetaObject::invokeMethod(input, [input]() { Q_EMIT input->finished(); }, Qt::QueuedConnection);
+}
+
+void JoystickReader::apply(const Event &event)
+{
+	if (event.type == evAbs) {
+		const int axis = indexOf(axisCodes, event.code);
+		if (axis >= 0) {
+			mValues[static_cast<size_t>(axis)] = event.value;
+		}
+	} else if (event.type == evKey) {
+		const int button = indexOf(buttonCodes, event.code);
+		if (button >= 0) {
+			// Value 2 is autorepeat of a held button, it is ignored
+			const unsigned bit = 1u << button;
+			if (event.value == 1) {
+				mNewButtons |= bit & ~mPressedButtons;
+				mPressedButtons |= bit;
+			} else if (event.value == 0) {
+				mPressedButtons &= ~bit;
+			}
+		}
+	}
+}
+
+void JoystickReader::sample()
+{
+	for (int pad = 0; pad < 2; ++pad) {
+		const int axisX = 2 * pad;
+		const double x = normalized(axisX);
+		const double y = normalized(axisX + 1);
+		const double magnitude = std::hypot(x, y);
+
+		// Deadzone of the device itself is respected if it is wider
+		const auto &range = mRanges[static_cast<size_t>(axisX)];
+		const double flat = 2.0 * range.flat / (range.maximum - range.minimum);
+		const double zone = qBound(0.0, qMax(deadzone, flat), 0.95);
+
+		auto command = GamepadCommand::padUp(pad + 1);
+		if (magnitude > zone) {
+			// Travel outside the deadzone is stretched to the whole range, so the first step is small
+			const double scale = qMin(1.0, (magnitude - zone) / (1.0 - zone)) / magnitude;
+
+			// Stick axes grow downwards, pads --- upwards
+			command = GamepadCommand::pad(pad + 1, static_cast<int>(std::lround(100.0 * x * scale))
+					, static_cast<int>(std::lround(-100.0 * y * scale)));
+		}
+
+		// Sticks start released, so a stick resting in its deadzone emits nothing
+		auto &last = mSticks[static_cast<size_t>(pad)];
+		const bool wasHeld = last.type == GamepadCommand::Type::pad;
+		const bool isHeld = command.type == GamepadCommand::Type::pad;
+		if (wasHeld != isHeld || (isHeld && (last.x != command.x || last.y != command.y))) {
+			last = command;
+			InputEvent event;
+			event.kind = InputEvent::Kind::stick;
+			event.stick = command;
+			post(event);
+		}
+	}
+
+	// A button pressed and released between two samples is emitted too
+	for (int button = 0; button < buttonCount; ++button) {
+		const unsigned bit = 1u << button;
+		InputEvent event;
+		event.key = ControlKeys::keyOf(ControlKeys::digit1 + button);
+		if ((mNewButtons & bit) && !(mPostedButtons & bit)) {
+			mPostedButtons |= bit;
+			event.type = QEvent::KeyPress;
+			post(event);
+		}
+
+		if ((mPostedButtons & bit) && !(mPressedButtons & bit)) {
+			mPostedButtons &= ~bit;
+			event.type = QEvent::KeyRelease;
+			post(event);
+		}
+	}
+
+	mNewButtons = 0;
+}
+
+void JoystickReader::stop()
+{
+	centerSticks();
+	mPressedButtons = 0;
+	mNewButtons = 0;
+	sample();
+	mSampleTimer->stop();
+}
+
+void JoystickReader::post(const InputEvent &event)
+{
+	Q_EMIT mInput->inputReady(event);
+}
+
+void JoystickReader::centerSticks()
+{
+	for (size_t axis = 0; axis < mValues.size(); ++axis) {
+		mValues[axis] = mRanges[axis].minimum + (mRanges[axis].maximum - mRanges[axis].minimum) / 2;
+	}
+}
+
+double JoystickReader::normalized(int axis) const
+{
+	const auto &range = mRanges[static_cast<size_t>(axis)];
+	const double half = (range.maximum - range.minimum) / 2.0;
+	if (half <= 0) {
+		return 0;
+	}
+
+	const double center = range.minimum + half;
+	return qBound(-1.0, (mValues[static_cast<size_t>(axis)] - center) / half, 1.0);
+}
+
+JoystickInput::JoystickInput(QObject *parent)
+	: QObject(parent)
+	, mReader(new JoystickReader(this))
+{
+	qRegisterMetaType<InputEvent>();
+	mThread.setObjectName("joystick");
+}
+
+JoystickInput::~JoystickInput()
+{
+	if (mThread.isRunning()) {
+		mThread.quit();
+		mThread.wait();
+	} else {
+		delete mReader;
+	}
+}
+
+void JoystickInput::setRate(int rate)
+{
+	mReader->rate = qBound(1, rate, ControlScheduler::maxRate);
+}
+
+void JoystickInput::setDeadzone(double deadzone)
+{
+	mReader->deadzone = deadzone;
+}
+
+bool JoystickInput::open(const QString &source)
+{
+	return source.startsWith("/dev/") ? mReader->openDevice(source, mError) : mReader->openDump(source, mError);
+}
+
+void JoystickInput::start()
+{
+	mReader->moveToThread(&mThread);
+	connect(&mThread, &QThread::finished, mReader, &QObject::deleteLater);
+	mThread.start();
+	auto reader = mReader;
+	QMetaObject::invokeMethod(reader, [reader]() { reader->run(); }, Qt::QueuedConnection);
+}
+
+QString JoystickInput::errorString() const
+{
+	return mError;
+}
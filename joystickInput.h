@@ -0,0 +1,68 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+
+#include "inputQueue.h"
+
+class JoystickReader;
+
+/// Drives pads with analog sticks of a joystick along with keys. Events come from a Linux evdev device
+/// (/dev/input/eventN) or from a dump recorded by evemu-record, so the pipeline is testable without hardware.
+/// Left stick moves pad 1, right stick moves pad 2, proportionally and with a radial deadzone; south, east, north,
+/// west and left shoulder buttons press keys of magic buttons 1 to 5. Reading and mapping happen in a background
+/// thread, sticks are sampled at a bounded rate and only changes are emitted as input for strategies, see
+/// StrategyController::postDeviceInput().
+class JoystickInput : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(JoystickInput)
+
+public:
+	explicit JoystickInput(QObject *parent = nullptr);
+
+	/// Stops background thread
+	~JoystickInput() override;
+
+	/// Sets how many times a second pad positions are sampled, up to ControlScheduler::maxRate
+	void setRate(int rate);
+
+	/// Sets share of stick travel around the center which is ignored, from 0 to 1
+	void setDeadzone(double deadzone);
+
+	/// Opens evdev device if source is in /dev, evemu-record dump otherwise. Returns false if it can not be read,
+	/// see errorString(). Settings shall be set before this call.
+	bool open(const QString &source);
+
+	/// Starts reading opened source in background thread. Dump is replayed with its recorded timing.
+	void start();
+
+	/// Description of the last error
+	QString errorString() const;
+
+signals:
+	/// Stick position or button key event, emitted in background thread
+	void inputReady(const InputEvent &event);
+
+	/// Emitted when a dump is over and sticks are released
+	void finished();
+
+private:
+	QThread mThread;
+	JoystickReader *mReader {}; // Ownership is passed to the thread
+	QString mError;
+};
@@ -85,6 +85,22 @@
         <source>Connected to robot</source>
         <translation type="vanished">Verbunden mit Roboter</translation>
     </message>
+    <message>
+        <source>Pad transport:</source>
+        <translation>Übertragung der Pads:</translation>
+    </message>
+    <message>
+        <source>TCP</source>
+        <translation>TCP</translation>
+    </message>
+    <message>
+        <source>UDP</source>
+        <translation>UDP</translation>
+    </message>
+    <message>
+        <source>Binary protocol</source>
+        <translation>Binärprotokoll</translation>
+    </message>
 </context>
 <context>
     <name>GamepadForm</name>
@@ -259,5 +275,81 @@ Buttons aktiviert.</translation>
         <source>This is desktop gamepad for TRIK robots.</source>
         <translation>Dies ist Desktop-Gamepad für TRIK Roboter.</translation>
     </message>
+    <message>
+        <source>&amp;Robots</source>
+        <translation>&amp;Roboter</translation>
+    </message>
+    <message>
+        <source>&amp;Add robot...</source>
+        <translation>Roboter &amp;hinzufügen...</translation>
+    </message>
+    <message>
+        <source>Re&amp;move robot</source>
+        <translation>Roboter &amp;entfernen</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2)</source>
+        <translation>Roboter %1 (%2)</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2): %3</source>
+        <translation>Roboter %1 (%2): %3</translation>
+    </message>
+    <message>
+        <source>connected</source>
+        <translation>verbunden</translation>
+    </message>
+    <message>
+        <source>connecting</source>
+        <translation>verbinde</translation>
+    </message>
+    <message>
+        <source>disconnected</source>
+        <translation>getrennt</translation>
+    </message>
+    <message>
+        <source>%1 ms</source>
+        <translation>%1 ms</translation>
+    </message>
+    <message>
+        <source>Too many robots</source>
+        <translation>Zu viele Roboter</translation>
+    </message>
+    <message>
+        <source>No more robots can be driven at once.</source>
+        <translation>Mehr Roboter können nicht gleichzeitig gesteuert werden.</translation>
+    </message>
+    <message>
+        <source>Connection restored in %1 ms</source>
+        <translation>Verbindung in %1 ms wiederhergestellt</translation>
+    </message>
+    <message>
+        <source>RTT %1/%2/%3 ms, jitter %4 ms, loss %5%</source>
+        <translation>RTT %1/%2/%3 ms, Jitter %4 ms, Verlust %5%</translation>
+    </message>
+    <message>
+        <source>Robot is not responding, reconnecting...</source>
+        <translation>Roboter antwortet nicht, neue Verbindung wird aufgebaut...</translation>
+    </message>
+    <message>
+        <source>Round-trip time median, 95th and 99th percentiles over %1 probes.
+Pad commands sent: %2, not sent as unchanged: %3</source>
+        <translation>Median, 95. und 99. Perzentil der Umlaufzeit über %1 Messungen.
+Gesendete Pad-Befehle: %2, unverändert nicht gesendet: %3</translation>
+    </message>
+    <message>
+        <source>unknown</source>
+        <translation>unbekannt</translation>
+    </message>
+    <message>
+        <source>Video frames are decoded at 1/%1 scale, %2x%3.
+Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.
+Frames are shown %7 ms after they are received on average, %8 ms at most.
+Frames dropped as outdated: %9 before decoding, %10 before showing.</source>
+        <translation>Videobilder werden im Maßstab 1/%1 dekodiert, %2x%3.
+Das Dekodieren dauert %4 ms pro Bild, CPU-Zeit %5 ms, %6 Bilder pro Sekunde.
+Bilder werden im Mittel %7 ms nach dem Empfang angezeigt, höchstens nach %8 ms.
+Als veraltet verworfene Bilder: %9 vor dem Dekodieren, %10 vor dem Anzeigen.</translation>
+    </message>
 </context>
 </TS>
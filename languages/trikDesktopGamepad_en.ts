@@ -85,6 +85,22 @@
         <source>Connected to robot</source>
         <translation type="vanished">Connected to robot</translation>
     </message>
+    <message>
+        <source>Pad transport:</source>
+        <translation>Pad transport:</translation>
+    </message>
+    <message>
+        <source>TCP</source>
+        <translation>TCP</translation>
+    </message>
+    <message>
+        <source>UDP</source>
+        <translation>UDP</translation>
+    </message>
+    <message>
+        <source>Binary protocol</source>
+        <translation>Binary protocol</translation>
+    </message>
 </context>
 <context>
     <name>GamepadForm</name>
@@ -259,5 +275,81 @@ Buttons enabled.</translation>
         <source>About TRIK Gamepad</source>
         <translation>About TRIK Gamepad</translation>
     </message>
+    <message>
+        <source>&amp;Robots</source>
+        <translation>&amp;Robots</translation>
+    </message>
+    <message>
+        <source>&amp;Add robot...</source>
+        <translation>&amp;Add robot...</translation>
+    </message>
+    <message>
+        <source>Re&amp;move robot</source>
+        <translation>Re&amp;move robot</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2)</source>
+        <translation>Robot %1 (%2)</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2): %3</source>
+        <translation>Robot %1 (%2): %3</translation>
+    </message>
+    <message>
+        <source>connected</source>
+        <translation>connected</translation>
+    </message>
+    <message>
+        <source>connecting</source>
+        <translation>connecting</translation>
+    </message>
+    <message>
+        <source>disconnected</source>
+        <translation>disconnected</translation>
+    </message>
+    <message>
+        <source>%1 ms</source>
+        <translation>%1 ms</translation>
+    </message>
+    <message>
+        <source>Too many robots</source>
+        <translation>Too many robots</translation>
+    </message>
+    <message>
+        <source>No more robots can be driven at once.</source>
+        <translation>No more robots can be driven at once.</translation>
+    </message>
+    <message>
+        <source>Connection restored in %1 ms</source>
+        <translation>Connection restored in %1 ms</translation>
+    </message>
+    <message>
+        <source>RTT %1/%2/%3 ms, jitter %4 ms, loss %5%</source>
+        <translation>RTT %1/%2/%3 ms, jitter %4 ms, loss %5%</translation>
+    </message>
+    <message>
+        <source>Robot is not responding, reconnecting...</source>
+        <translation>Robot is not responding, reconnecting...</translation>
+    </message>
+    <message>
+        <source>Round-trip time median, 95th and 99th percentiles over %1 probes.
+Pad commands sent: %2, not sent as unchanged: %3</source>
+        <translation>Round-trip time median, 95th and 99th percentiles over %1 probes.
+Pad commands sent: %2, not sent as unchanged: %3</translation>
+    </message>
+    <message>
+        <source>unknown</source>
+        <translation>unknown</translation>
+    </message>
+    <message>
+        <source>Video frames are decoded at 1/%1 scale, %2x%3.
+Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.
+Frames are shown %7 ms after they are received on average, %8 ms at most.
+Frames dropped as outdated: %9 before decoding, %10 before showing.</source>
+        <translation>Video frames are decoded at 1/%1 scale, %2x%3.
+Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.
+Frames are shown %7 ms after they are received on average, %8 ms at most.
+Frames dropped as outdated: %9 before decoding, %10 before showing.</translation>
+    </message>
 </context>
 </TS>
@@ -85,6 +85,22 @@
         <source>Connected to robot</source>
         <translation type="vanished">Connecté au robot de</translation>
     </message>
+    <message>
+        <source>Pad transport:</source>
+        <translation>Transport des pads :</translation>
+    </message>
+    <message>
+        <source>TCP</source>
+        <translation>TCP</translation>
+    </message>
+    <message>
+        <source>UDP</source>
+        <translation>UDP</translation>
+    </message>
+    <message>
+        <source>Binary protocol</source>
+        <translation>Protocole binaire</translation>
+    </message>
 </context>
 <context>
     <name>GamepadForm</name>
@@ -259,5 +275,81 @@ Boutons activés.</translation>
         <source>This is desktop gamepad for TRIK robots.</source>
         <translation>Ceci est gamepad de bureau pour les robots TRIK.</translation>
     </message>
+    <message>
+        <source>&amp;Robots</source>
+        <translation>&amp;Robots</translation>
+    </message>
+    <message>
+        <source>&amp;Add robot...</source>
+        <translation>&amp;Ajouter un robot...</translation>
+    </message>
+    <message>
+        <source>Re&amp;move robot</source>
+        <translation>&amp;Supprimer un robot</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2)</source>
+        <translation>Robot %1 (%2)</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2): %3</source>
+        <translation>Robot %1 (%2) : %3</translation>
+    </message>
+    <message>
+        <source>connected</source>
+        <translation>connecté</translation>
+    </message>
+    <message>
+        <source>connecting</source>
+        <translation>connexion</translation>
+    </message>
+    <message>
+        <source>disconnected</source>
+        <translation>déconnecté</translation>
+    </message>
+    <message>
+        <source>%1 ms</source>
+        <translation>%1 ms</translation>
+    </message>
+    <message>
+        <source>Too many robots</source>
+        <translation>Trop de robots</translation>
+    </message>
+    <message>
+        <source>No more robots can be driven at once.</source>
+        <translation>Impossible de piloter plus de robots à la fois.</translation>
+    </message>
+    <message>
+        <source>Connection restored in %1 ms</source>
+        <translation>Connexion rétablie en %1 ms</translation>
+    </message>
+    <message>
+        <source>RTT %1/%2/%3 ms, jitter %4 ms, loss %5%</source>
+        <translation>RTT %1/%2/%3 ms, gigue %4 ms, pertes %5%</translation>
+    </message>
+    <message>
+        <source>Robot is not responding, reconnecting...</source>
+        <translation>Le robot ne répond pas, reconnexion...</translation>
+    </message>
+    <message>
+        <source>Round-trip time median, 95th and 99th percentiles over %1 probes.
+Pad commands sent: %2, not sent as unchanged: %3</source>
+        <translation>Médiane, 95e et 99e centiles du temps aller-retour sur %1 mesures.
+Commandes de pad envoyées : %2, non envoyées car inchangées : %3</translation>
+    </message>
+    <message>
+        <source>unknown</source>
+        <translation>inconnu</translation>
+    </message>
+    <message>
+        <source>Video frames are decoded at 1/%1 scale, %2x%3.
+Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.
+Frames are shown %7 ms after they are received on average, %8 ms at most.
+Frames dropped as outdated: %9 before decoding, %10 before showing.</source>
+        <translation>Les images vidéo sont décodées à l&apos;échelle 1/%1, %2x%3.
+Le décodage prend %4 ms par image, temps CPU %5 ms, %6 images par seconde.
+Les images sont affichées en moyenne %7 ms après leur réception, %8 ms au plus.
+Images abandonnées car périmées : %9 avant le décodage, %10 avant l&apos;affichage.</translation>
+    </message>
 </context>
 </TS>
@@ -89,6 +89,22 @@
         <source>Robot IP</source>
         <translation type="obsolete">IP робота</translation>
     </message>
+    <message>
+        <source>Pad transport:</source>
+        <translation>Передача положения джойстиков:</translation>
+    </message>
+    <message>
+        <source>TCP</source>
+        <translation>TCP</translation>
+    </message>
+    <message>
+        <source>UDP</source>
+        <translation>UDP</translation>
+    </message>
+    <message>
+        <source>Binary protocol</source>
+        <translation>Двоичный протокол</translation>
+    </message>
 </context>
 <context>
     <name>GamepadForm</name>
@@ -263,5 +279,81 @@ Buttons enabled.</source>
         <source>About TRIK Gamepad</source>
         <translation>О пульте управления ТРИК</translation>
     </message>
+    <message>
+        <source>&amp;Robots</source>
+        <translation>&amp;Роботы</translation>
+    </message>
+    <message>
+        <source>&amp;Add robot...</source>
+        <translation>&amp;Добавить робота...</translation>
+    </message>
+    <message>
+        <source>Re&amp;move robot</source>
+        <translation>&amp;Удалить робота</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2)</source>
+        <translation>Робот %1 (%2)</translation>
+    </message>
+    <message>
+        <source>Robot %1 (%2): %3</source>
+        <translation>Робот %1 (%2): %3</translation>
+    </message>
+    <message>
+        <source>connected</source>
+        <translation>подключен</translation>
+    </message>
+    <message>
+        <source>connecting</source>
+        <translation>подключение</translation>
+    </message>
+    <message>
+        <source>disconnected</source>
+        <translation>отключен</translation>
+    </message>
+    <message>
+        <source>%1 ms</source>
+        <translation>%1 мс</translation>
+    </message>
+    <message>
+        <source>Too many robots</source>
+        <translation>Слишком много роботов</translation>
+    </message>
+    <message>
+        <source>No more robots can be driven at once.</source>
+        <translation>Больше роботов одновременно управлять нельзя.</translation>
+    </message>
+    <message>
+        <source>Connection restored in %1 ms</source>
+        <translation>Соединение восстановлено за %1 мс</translation>
+    </message>
+    <message>
+        <source>RTT %1/%2/%3 ms, jitter %4 ms, loss %5%</source>
+        <translation>RTT %1/%2/%3 мс, джиттер %4 мс, потери %5%</translation>
+    </message>
+    <message>
+        <source>Robot is not responding, reconnecting...</source>
+        <translation>Робот не отвечает, переподключение...</translation>
+    </message>
+    <message>
+        <source>Round-trip time median, 95th and 99th percentiles over %1 probes.
+Pad commands sent: %2, not sent as unchanged: %3</source>
+        <translation>Медиана, 95-й и 99-й процентили времени приёма-передачи по %1 замерам.
+Отправлено команд джойстиков: %2, не отправлено без изменений: %3</translation>
+    </message>
+    <message>
+        <source>unknown</source>
+        <translation>неизвестно</translation>
+    </message>
+    <message>
+        <source>Video frames are decoded at 1/%1 scale, %2x%3.
+Decoding takes %4 ms per frame, CPU time %5 ms, %6 frames a second.
+Frames are shown %7 ms after they are received on average, %8 ms at most.
+Frames dropped as outdated: %9 before decoding, %10 before showing.</source>
+        <translation>Кадры видео декодируются в масштабе 1/%1, %2x%3.
+Декодирование занимает %4 мс на кадр, процессорное время %5 мс, %6 кадров в секунду.
+Кадры показываются в среднем через %7 мс после получения, не более чем через %8 мс.
+Устаревших кадров отброшено: %9 до декодирования, %10 до показа.</translation>
+    </message>
 </context>
 </TS>
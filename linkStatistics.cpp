@@ -0,0 +1,84 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "linkStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+void LinkStatistics::addSample(qint64 rtt)
+{
+	mSamples[static_cast<size_t>(mNextSample)] = rtt;
+	mNextSample = (mNextSample + 1) % window;
+	if (mSampleCount < window) {
+		++mSampleCount;
+	}
+
+	if (mLastSample >= 0) {
+		constexpr double smoothing = 1.0 / 16;
+		mJitter += (std::abs(static_cast<double>(rtt - mLastSample)) - mJitter) * smoothing;
+	}
+
+	mLastSample = rtt;
+	addOutcome(true);
+}
+
+void LinkStatistics::addLoss()
+{
+	addOutcome(false);
+}
+
+void LinkStatistics::clear()
+{
+	*this = LinkStatistics();
+}
+
+LinkQuality LinkStatistics::quality() const
+{
+	LinkQuality result;
+	result.samples = mSampleCount;
+	result.jitter = mJitter / 1000;
+	result.loss = mOutcomeCount ? static_cast<double>(mLost) / mOutcomeCount : 0.0;
+	if (mSampleCount == 0) {
+		return result;
+	}
+
+	auto sorted = mSamples;
+	const auto begin = sorted.begin();
+	const auto end = begin + mSampleCount;
+	const auto percentile = [begin, end, this](int percent) {
+		const auto nth = begin + (mSampleCount - 1) * percent / 100;
+		std::nth_element(begin, nth, end);
+		return static_cast<double>(*nth) / 1000;
+	};
+
+	result.rttP50 = percentile(50);
+	result.rttP95 = percentile(95);
+	result.rttP99 = percentile(99);
+	return result;
+}
+
+void LinkStatistics::addOutcome(bool answered)
+{
+	const auto slot = static_cast<size_t>(mNextOutcome);
+	if (mOutcomeCount == window) {
+		mLost -= mOutcomes[slot] ? 0 : 1;
+	} else {
+		++mOutcomeCount;
+	}
+
+	mOutcomes[slot] = answered;
+	mLost += answered ? 0 : 1;
+	mNextOutcome = (mNextOutcome + 1) % window;
+}
@@ -0,0 +1,70 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMetaType>
+
+#include <array>
+
+/// Summary of link quality over recent probes. Times are in milliseconds, loss is a fraction from 0 to 1.
+struct LinkQuality
+{
+	/// Number of round-trip time samples the summary is based on
+	int samples {};
+	double rttP50 {};
+	double rttP95 {};
+	double rttP99 {};
+	double jitter {};
+	double loss {};
+};
+
+Q_DECLARE_METATYPE(LinkQuality)
+
+/// Rolling statistics of round-trip times measured by ping/echo probes.
+class LinkStatistics
+{
+public:
+	/// Number of recent probes statistics is computed over
+	static constexpr int window = 256;
+
+	/// Adds round-trip time of answered probe, in microseconds
+	void addSample(qint64 rtt);
+
+	/// Accounts probe that was not answered in time
+	void addLoss();
+
+	/// Forgets all samples
+	void clear();
+
+	/// Computes percentiles, jitter and loss over the window
+	LinkQuality quality() const;
+
+private:
+	/// Remembers outcome of a probe for loss estimation
+	void addOutcome(bool answered);
+
+	std::array<qint64, window> mSamples {};
+	int mSampleCount {};
+	int mNextSample {};
+
+	std::array<bool, window> mOutcomes {};
+	int mOutcomeCount {};
+	int mNextOutcome {};
+	int mLost {};
+
+	/// Smoothed mean deviation of consecutive samples, as in RFC 3550
+	double mJitter {};
+	qint64 mLastSample { -1 };
+};
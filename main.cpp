@@ -35,9 +35,24 @@
 #include "thirdparty/SingleApplication/singleapplication.h"
 
 #include "gamepadForm.h"
+#include "headlessDriver.h"
 
 int main(int argc, char *argv[])
 {
+	/// gamepad --headless [--script file] [--mode standard|accelerate] gamepadIp [gamepadPort]
+	/// drives the robot by a script without any window, see HeadlessDriver for script format
+	if (HeadlessDriver::isRequested(argc, argv)) {
+		QCoreApplication application(argc, argv);
+		HeadlessDriver driver;
+		QObject::connect(&driver, &HeadlessDriver::finished, &application, &QCoreApplication::exit
+				, Qt::QueuedConnection);
+		if (!driver.start(application.arguments())) {
+			return 2;
+		}
+
+		return application.exec();
+	}
+
 	SingleApplication a(argc, argv);
 	GamepadForm w;
 	w.setWindowIcon(QIcon(":/images/icon.png"));
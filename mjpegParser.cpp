@@ -0,0 +1,237 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "mjpegParser.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QList>
+
+constexpr int MjpegParser::maxBuffered;
+
+namespace {
+
+const char headerEnd[] = "\r\n\r\n";
+constexpr int headerEndSize = 4;
+
+/// Value of "name: value" header, empty if there is no such header
+QByteArray headerValue(const QList<QByteArray> &lines, const QByteArray &name)
+{
+	for (const auto &line : lines) {
+		const int colon = line.indexOf(':');
+		if (colon > 0 && line.left(colon).trimmed().toLower() == name) {
+			return line.mid(colon + 1).trimmed();
+		}
+	}
+
+	return {};
+}
+
+}
+
+void MjpegParser::reset()
+{
+	mBuffer.clear();
+	mPosition = 0;
+	mSearchFrom = 0;
+	mNewestStart = -1;
+	mNewestSize = 0;
+	mState = State::httpHeader;
+	mDelimiter.clear();
+	mDelimiterConfirmed = false;
+	mLength = -1;
+	mError.clear();
+}
+
+bool MjpegParser::read(QIODevice &device)
+{
+	if (mState == State::failed) {
+		return false;
+	}
+
+	// Data before position was handed out as frames nobody refers to any more, but the newest one, which is kept
+	// at the start of the buffer unless it leaves no room for more data. Only the tail is moved.
+	int consumed = mNewestStart >= 0 ? mNewestStart : mPosition;
+	if (mNewestStart >= 0 && mBuffer.size() - consumed >= maxBuffered) {
+		consumed = mPosition;
+		mNewestStart = -1;
+	}
+
+	if (consumed > 0) {
+		mBuffer.remove(0, consumed);
+		mSearchFrom -= consumed;
+		mPosition -= consumed;
+		mNewestStart = mNewestStart >= 0 ? 0 : -1;
+	}
+
+	const qint64 available = device.bytesAvailable();
+	if (available <= 0) {
+		return true;
+	}
+
+	// A backlog of many frames after a stall is taken in chunks, only a frame filling the buffer alone is too large
+	const int size = mBuffer.size();
+	const qint64 room = maxBuffered - size;
+	if (room <= 0) {
+		fail("Video stream has a frame larger than buffer");
+		return false;
+	}
+
+	const qint64 chunk = qMin(available, room);
+	mBuffer.resize(size + static_cast<int>(chunk));
+	const qint64 received = device.read(mBuffer.data() + size, chunk);
+	mBuffer.resize(size + static_cast<int>(qMax<qint64>(received, 0)));
+	return true;
+}
+
+bool MjpegParser::next(QByteArray &jpeg)
+{
+	for (;;) {
+		switch (mState) {
+		case State::httpHeader:
+		case State::partHeader: {
+			// Part header follows CRLF ending the previous part, so empty lines before it are skipped
+			while (mState == State::partHeader && mBuffer.size() - mPosition >= 2
+					&& mBuffer.at(mPosition) == '\r' && mBuffer.at(mPosition + 1) == '\n') {
+				mPosition += 2;
+			}
+
+			const int end = mBuffer.indexOf(headerEnd, mPosition);
+			if (end < 0) {
+				return false;
+			}
+
+			const auto &header = mBuffer.mid(mPosition, end - mPosition);
+			const bool isHttpHeader = mState == State::httpHeader;
+			if (!(isHttpHeader ? parseHttpHeader(header) : parsePartHeader(header))) {
+				return false;
+			}
+
+			mPosition = end + headerEndSize;
+			mSearchFrom = mPosition;
+			mState = isHttpHeader ? State::partHeader : State::body;
+			break;
+		}
+		case State::body: {
+			int length = mLength;
+			if (length < 0) {
+				const int end = mBuffer.indexOf(mDelimiter, mSearchFrom);
+				if (end < 0) {
+					// The delimiter may be cut by the end of the buffer, so its beginning is looked at again
+					mSearchFrom = qMax(mPosition, static_cast<int>(mBuffer.size() - mDelimiter.size()) + 1);
+					return false;
+				}
+
+				length = end - mPosition;
+			} else if (mBuffer.size() - mPosition < length) {
+				return false;
+			}
+
+			jpeg = QByteArray::fromRawData(mBuffer.constData() + mPosition, length);
+			mNewestStart = mPosition;
+			mNewestSize = length;
+			mPosition += length;
+			mState = State::partHeader;
+			return true;
+		}
+		case State::failed:
+			return false;
+		}
+	}
+}
+
+bool MjpegParser::newest(QByteArray &jpeg) const
+{
+	if (mNewestStart < 0) {
+		return false;
+	}
+
+	jpeg = QByteArray::fromRawData(mBuffer.constData() + mNewestStart, mNewestSize);
+	return true;
+}
+
+bool MjpegParser::hasFailed() const
+{
+	return mState == State::failed;
+}
+
+QString MjpegParser::errorString() const
+{
+	return mError;
+}
+
+bool MjpegParser::parseHttpHeader(const QByteArray &header)
+{
+	const auto &lines = header.split('\n');
+	const auto &status = lines.first().simplified().split(' ');
+	if (status.size() < 2 || !status[0].startsWith("HTTP/") || status[1] != "200") {
+		fail(QString("Video server answered %1").arg(QString::fromLatin1(lines.first().trimmed())));
+		return false;
+	}
+
+	const auto &type = headerValue(lines, "content-type");
+	const int parameter = type.indexOf("boundary=");
+	if (!type.startsWith("multipart/") || parameter < 0) {
+		fail(QString("Video server sends %1 instead of MJPEG").arg(QString::fromLatin1(type)));
+		return false;
+	}
+
+	auto boundary = type.mid(parameter + static_cast<int>(sizeof("boundary=")) - 1);
+	const int semicolon = boundary.indexOf(';');
+	if (semicolon >= 0) {
+		boundary.truncate(semicolon);
+	}
+
+	boundary = boundary.trimmed();
+	if (boundary.startsWith('"') && boundary.endsWith('"') && boundary.size() >= 2) {
+		boundary = boundary.mid(1, boundary.size() - 2);
+	}
+
+	// Boundary may start with dashes itself, so they are always added. The first part header tells whether the server
+	// put dashes of the boundary line into the parameter instead, see parsePartHeader().
+	mDelimiter = "\r\n--" + boundary;
+	mDelimiterConfirmed = false;
+	return true;
+}
+
+bool MjpegParser::parsePartHeader(const QByteArray &header)
+{
+	const auto &lines = header.split('\n');
+	const auto &boundaryLine = lines.first().trimmed();
+	if (!boundaryLine.startsWith(mDelimiter.mid(2))) {
+		// Some servers put dashes of the boundary line into the parameter, this is accepted for the first part only
+		const auto &boundary = mDelimiter.mid(4);
+		if (mDelimiterConfirmed || !boundary.startsWith("--") || !boundaryLine.startsWith(boundary)) {
+			fail("Video stream part does not start with boundary");
+			return false;
+		}
+
+		mDelimiter = "\r\n" + boundary;
+	}
+
+	mDelimiterConfirmed = true;
+
+	bool ok = false;
+	mLength = headerValue(lines, "content-length").toInt(&ok);
+	if (!ok || mLength < 0) {
+		mLength = -1;
+	}
+
+	return true;
+}
+
+void MjpegParser::fail(const QString &reason)
+{
+	mState = State::failed;
+	mError = reason;
+}
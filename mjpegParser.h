@@ -0,0 +1,91 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+class QIODevice;
+
+/// Incremental parser of MJPEG over HTTP as mjpg-streamer sends it: HTTP response header with multipart
+/// content type, then parts of a JPEG each, separated by the boundary. Data is read straight into one buffer and
+/// JPEG frames are handed out as views into it, so a frame is never copied. Parts with Content-Length are cut
+/// by it, others at the next boundary.
+class MjpegParser
+{
+public:
+	/// Largest amount of data buffered, a stream with a frame that does not fit is broken
+	static constexpr int maxBuffered = 16 * 1024 * 1024;
+
+	/// Forgets everything, the next data shall start with HTTP response header
+	void reset();
+
+	/// Reads from device as much as fits into the buffer, the rest is left in the device for the next call once
+	/// frames are taken by next(). Frames returned by next() before are invalidated, the newest of them stays
+	/// buffered and is available through newest().
+	/// Returns false if the stream is broken, see errorString().
+	bool read(QIODevice &device);
+
+	/// Takes the next complete frame. Frame refers to the buffer of the parser and stays valid until the next
+	/// read() or reset(). Returns false if there is no complete frame buffered.
+	bool next(QByteArray &jpeg);
+
+	/// Takes the frame last returned by next(), valid until the next read() or reset(). Unlike frames returned
+	/// by next(), it survives read() unless the buffer is full. Returns false if there is no such frame.
+	bool newest(QByteArray &jpeg) const;
+
+	/// Returns true if the stream turned out to be broken
+	bool hasFailed() const;
+
+	/// Description of what is wrong with the stream
+	QString errorString() const;
+
+private:
+	enum class State {
+		httpHeader
+		, partHeader
+		, body
+		, failed
+	};
+
+	bool parseHttpHeader(const QByteArray &header);
+	bool parsePartHeader(const QByteArray &header);
+	void fail(const QString &reason);
+
+	QByteArray mBuffer;
+
+	/// Start of unparsed data in the buffer, data before it was handed out
+	int mPosition {};
+
+	/// Where to continue looking for the boundary ending a part without Content-Length
+	int mSearchFrom {};
+
+	/// Position and size of the frame last returned by next(), start is -1 if it is not buffered any more
+	int mNewestStart { -1 };
+	int mNewestSize {};
+
+	State mState { State::httpHeader };
+
+	/// Boundary line with leading "--" and CRLF before it, as it ends a part
+	QByteArray mDelimiter;
+
+	/// Set once the first part header confirms the delimiter
+	bool mDelimiterConfirmed {};
+
+	/// Length of current part, -1 if it is not known
+	int mLength { -1 };
+
+	QString mError;
+};
@@ -0,0 +1,413 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "mjpegStreamClient.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QImageReader>
+#include <QtNetwork/QTcpSocket>
+
+#include <chrono>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+	#include <time.h>
+#elif defined(Q_OS_WIN)
+	#include <windows.h>
+#endif
+
+#include "mjpegParser.h"
+
+/// CPU time consumed by the calling thread, in ns, -1 if the platform does not tell it
+static qint64 threadCpuTime()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+	timespec time {};
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+		return static_cast<qint64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+	}
+#elif defined(Q_OS_WIN)
+	FILETIME creation {};
+	FILETIME exit {};
+	FILETIME kernel {};
+	FILETIME user {};
+	if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+		const auto ticks = [](const FILETIME &time) {
+			return static_cast<qint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+		};
+		// In 100 ns ticks, advancing with scheduler quantum, so only the mean over many frames makes sense
+		return (ticks(kernel) + ticks(user)) * 100;
+	}
+#endif
+	return -1;
+}
+
+/// Works in decoder thread of MjpegStreamClient: takes the newest received frame, decodes it and hands it over
+/// to GUI thread
+class MjpegDecoder : public QObject
+{
+public:
+	explicit MjpegDecoder(MjpegStreamClient *client)
+		: mClient(client)
+	{
+	}
+
+	void setTargetSize(const QSize &size)
+	{
+		mTargetSize = size;
+	}
+
+	/// Decodes frame waiting in the mailbox, if it was not taken by previous call
+	void decodeNext()
+	{
+		MjpegStreamClient::EncodedFrame encoded;
+		if (!mClient->mEncoded.take(encoded)) {
+			return;
+		}
+
+		MjpegStreamClient::DecodedFrame decoded { {}, encoded.receivedAt, encoded.stream };
+		if (!decode(encoded.jpeg, decoded.image)) {
+			qDebug() << "Video stream: broken JPEG frame dropped";
+			return;
+		}
+
+		++mClient->mDecodedCount;
+		if (mClient->mDecoded.put(decoded)) {
+			const auto client = mClient;
+			QMetaObject::invokeMethod(client, [client]() { Q_EMIT client->frameReady(); }, Qt::QueuedConnection);
+		}
+	}
+
+private:
+	/// Decodes frame at the smallest scale filling target size, accounting time it took
+	bool decode(QByteArray jpeg, QImage &image)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		const qint64 cpuStart = threadCpuTime();
+
+		QBuffer buffer(&jpeg);
+		buffer.open(QIODevice::ReadOnly);
+		QImageReader reader(&buffer, "JPEG");
+		const QSize size = reader.size();
+		const int scale = MjpegStreamClient::decodeScale(size, mTargetSize);
+		if (scale > 1) {
+			// Qt JPEG plugin lets libjpeg scale by 1/2, 1/4 or 1/8 when the size asked for is that much smaller
+			reader.setScaledSize(QSize(size.width() / scale, size.height() / scale));
+		}
+
+		if (!reader.read(&image)) {
+			return false;
+		}
+
+		const qint64 cpuEnd = threadCpuTime();
+		mStatistics.decodeTime += timer.nsecsElapsed() / 1e6;
+		if (cpuStart < 0) {
+			mStatistics.cpuTime = -1;
+		} else {
+			mStatistics.cpuTime += (cpuEnd - cpuStart) / 1e6;
+		}
+
+		mStatistics.scale = scale;
+		mStatistics.size = image.size();
+		++mStatistics.frames;
+		if (!mStatisticsClock.isValid()) {
+			mStatisticsClock.start();
+		} else if (mStatisticsClock.elapsed() >= 1000) {
+			reportStatistics();
+		}
+
+		return true;
+	}
+
+	/// Hands mean decoding time over the period to the client and starts a new period
+	void reportStatistics()
+	{
+		auto statistics = mStatistics;
+		statistics.decodeTime /= statistics.frames;
+		if (statistics.cpuTime > 0) {
+			statistics.cpuTime /= statistics.frames;
+		}
+
+		const auto client = mClient;
+		QMetaObject::invokeMethod(client, [client, statistics]() { client->reportStatistics(statistics); }
+				, Qt::QueuedConnection);
+		mStatistics = {};
+		mStatisticsClock.restart();
+	}
+
+	MjpegStreamClient *mClient; // Doesn't have ownership
+	QSize mTargetSize;
+	VideoStatistics mStatistics;
+	QElapsedTimer mStatisticsClock;
+};
+
+/// Works in receiver thread of MjpegStreamClient: requests the stream, parses it and hands the newest frame over
+/// to the decoder
+class MjpegReceiver : public QObject
+{
+public:
+	MjpegReceiver(MjpegStreamClient *client, MjpegDecoder *decoder)
+		: mSocket(this)
+		, mClient(client)
+		, mDecoder(decoder)
+	{
+		connect(&mSocket, &QTcpSocket::connected, this, [this]() {
+			mSocket.write(QString("GET /?action=stream HTTP/1.0\r\nHost: %1\r\n\r\n").arg(mHost).toLatin1());
+		});
+		connect(&mSocket, &QTcpSocket::readyRead, this, [this]() { receive(); });
+		connect(&mSocket, &QTcpSocket::disconnected, this, [this]() {
+			report(MjpegStreamClient::State::failed);
+		});
+		const auto onError = [this]() {
+			qDebug().noquote() << "Video stream:" << mSocket.errorString();
+			report(MjpegStreamClient::State::failed);
+		};
+#ifdef TRIK_USE_QT6
+		connect(&mSocket, &QTcpSocket::errorOccurred, this, onError);
+#else
+		connect(&mSocket, static_cast<void(QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error)
+				, this, onError);
+#endif
+	}
+
+	void open(const QString &host, quint16 port, int stream)
+	{
+		close();
+		mStream = stream;
+		mHost = host;
+		mStreaming = false;
+		mParser.reset();
+		report(MjpegStreamClient::State::connecting);
+		mSocket.connectToHost(host, port);
+	}
+
+	void close()
+	{
+		// Stream is dropped on purpose, so it is not reported as failed
+		mSocket.blockSignals(true);
+		mSocket.abort();
+		mSocket.blockSignals(false);
+	}
+
+private:
+	void receive()
+	{
+		// Frames are views into parser buffer, only the newest one is worth handing over. A backlog larger than
+		// the buffer is parsed in chunks, parser keeps the newest frame of previous chunks buffered meanwhile.
+		QByteArray jpeg;
+		int frames = 0;
+		do {
+			if (!mParser.read(mSocket)) {
+				fail();
+				return;
+			}
+
+			while (mParser.next(jpeg)) {
+				++frames;
+			}
+
+			if (mParser.hasFailed()) {
+				fail();
+				return;
+			}
+		} while (mSocket.bytesAvailable() > 0);
+
+		if (frames == 0 || !mParser.newest(jpeg)) {
+			return;
+		}
+
+		mClient->mReceivedCount += frames;
+		mClient->mSkippedCount += frames - 1;
+		if (!mStreaming) {
+			mStreaming = true;
+			report(MjpegStreamClient::State::streaming);
+		}
+
+		// The only copy of the frame: it leaves parser buffer, which is reused by the next read
+		const MjpegStreamClient::EncodedFrame frame { QByteArray(jpeg.constData(), jpeg.size())
+				, MjpegStreamClient::now(), mStream };
+		if (mClient->mEncoded.put(frame)) {
+			const auto decoder = mDecoder;
+			QMetaObject::invokeMethod(decoder, [decoder]() { decoder->decodeNext(); }, Qt::QueuedConnection);
+		}
+	}
+
+	void fail()
+	{
+		qDebug().noquote() << "Video stream:" << mParser.errorString();
+		close();
+		report(MjpegStreamClient::State::failed);
+	}
+
+	void report(MjpegStreamClient::State state)
+	{
+		const auto client = mClient;
+		const int stream = mStream;
+		QMetaObject::invokeMethod(client, [client, state, stream]() { client->setState(state, stream); }
+				, Qt::QueuedConnection);
+	}
+
+	QTcpSocket mSocket;
+	MjpegParser mParser;
+	MjpegStreamClient *mClient; // Doesn't have ownership
+	MjpegDecoder *mDecoder; // Doesn't have ownership
+	QString mHost;
+	int mStream {};
+	bool mStreaming {};
+};
+
+MjpegStreamClient::MjpegStreamClient(QObject *parent)
+	: QObject(parent)
+	, mDecoder(new MjpegDecoder(this))
+{
+	mReceiver = new MjpegReceiver(this, mDecoder);
+
+	mReceiverThread.setObjectName("video");
+	mReceiver->moveToThread(&mReceiverThread);
+	connect(&mReceiverThread, &QThread::finished, mReceiver, &QObject::deleteLater);
+
+	mDecoderThread.setObjectName("video decoder");
+	mDecoder->moveToThread(&mDecoderThread);
+	connect(&mDecoderThread, &QThread::finished, mDecoder, &QObject::deleteLater);
+
+	mDecoderThread.start();
+	mReceiverThread.start();
+}
+
+MjpegStreamClient::~MjpegStreamClient()
+{
+	// Receiver posts frames to the decoder, so it stops first
+	mReceiverThread.quit();
+	mReceiverThread.wait();
+	mDecoderThread.quit();
+	mDecoderThread.wait();
+}
+
+void MjpegStreamClient::start(const QString &host, quint16 port)
+{
+	const int stream = ++mStream;
+	auto receiver = mReceiver;
+	QMetaObject::invokeMethod(receiver, [receiver, host, port, stream]() { receiver->open(host, port, stream); }
+			, Qt::QueuedConnection);
+}
+
+void MjpegStreamClient::stop()
+{
+	++mStream;
+	auto receiver = mReceiver;
+	QMetaObject::invokeMethod(receiver, [receiver]() { receiver->close(); }, Qt::QueuedConnection);
+	if (mState != State::idle) {
+		mState = State::idle;
+		Q_EMIT stateChanged(mState);
+	}
+}
+
+MjpegStreamClient::State MjpegStreamClient::state() const
+{
+	return mState;
+}
+
+bool MjpegStreamClient::takeFrame(QImage &frame)
+{
+	DecodedFrame decoded;
+	if (!mDecoded.take(decoded) || decoded.stream != mStream) {
+		return false;
+	}
+
+	const qint64 age = now() - decoded.receivedAt;
+	++mAgeSamples;
+	mAgeSum += age;
+	mAgeMax = qMax(mAgeMax, age);
+	++mPresentedCount;
+	frame = decoded.image;
+	return true;
+}
+
+qint64 MjpegStreamClient::receivedFrames() const
+{
+	return mReceivedCount;
+}
+
+qint64 MjpegStreamClient::decodedFrames() const
+{
+	return mDecodedCount;
+}
+
+qint64 MjpegStreamClient::presentedFrames() const
+{
+	return mPresentedCount;
+}
+
+qint64 MjpegStreamClient::droppedBeforeDecoding() const
+{
+	return mSkippedCount + mEncoded.dropped();
+}
+
+qint64 MjpegStreamClient::droppedBeforePresenting() const
+{
+	return mDecoded.dropped();
+}
+
+void MjpegStreamClient::setTargetSize(const QSize &size)
+{
+	auto decoder = mDecoder;
+	QMetaObject::invokeMethod(decoder, [decoder, size]() { decoder->setTargetSize(size); }, Qt::QueuedConnection);
+}
+
+int MjpegStreamClient::decodeScale(const QSize &frameSize, const QSize &targetSize)
+{
+	if (frameSize.isEmpty() || targetSize.isEmpty()) {
+		return 1;
+	}
+
+	const QSize shown = frameSize.scaled(targetSize, Qt::KeepAspectRatio);
+	int scale = 8;
+	while (scale > 1 && (frameSize.width() / scale < shown.width() || frameSize.height() / scale < shown.height())) {
+		scale /= 2;
+	}
+
+	return scale;
+}
+
+qint64 MjpegStreamClient::now()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void MjpegStreamClient::setState(State state, int stream)
+{
+	if (stream == mStream && state != mState) {
+		mState = state;
+		Q_EMIT stateChanged(mState);
+	}
+}
+
+void MjpegStreamClient::reportStatistics(VideoStatistics statistics)
+{
+	statistics.presented = mAgeSamples;
+	if (mAgeSamples > 0) {
+		statistics.meanAge = mAgeSum / 1000.0 / mAgeSamples;
+		statistics.maxAge = mAgeMax / 1000.0;
+	}
+
+	statistics.droppedBeforeDecoding = droppedBeforeDecoding();
+	statistics.droppedBeforePresenting = droppedBeforePresenting();
+	mAgeSamples = 0;
+	mAgeSum = 0;
+	mAgeMax = 0;
+	Q_EMIT statisticsChanged(statistics);
+}
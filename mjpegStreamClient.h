@@ -0,0 +1,172 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QSize>
+#include <QtCore/QThread>
+#include <QtGui/QImage>
+
+#include <atomic>
+
+#include "frameMailbox.h"
+
+class MjpegReceiver;
+class MjpegDecoder;
+
+/// How video of MJPEG stream was received, decoded and shown over the last second
+struct VideoStatistics
+{
+	/// Number of frames decoded
+	int frames {};
+
+	/// Frames are decoded at 1/scale of their size in each dimension
+	int scale { 1 };
+	QSize size;
+
+	/// Mean wall time of decoding a frame, in ms
+	double decodeTime {};
+
+	/// Mean CPU time of decoding a frame, in ms, -1 if the platform does not tell it
+	double cpuTime {};
+
+	/// Number of frames shown
+	int presented {};
+
+	/// Mean and maximal time from receiving a frame to painting it, in ms
+	double meanAge {};
+	double maxAge {};
+
+	/// Frames dropped since the client was created, as newer ones came before they were decoded or shown
+	qint64 droppedBeforeDecoding {};
+	qint64 droppedBeforePresenting {};
+};
+
+/// Shows video of mjpg-streamer without QMediaPlayer, whose backends buffer the stream for hundreds of
+/// milliseconds. Stream is received and split by MjpegParser in one background thread and decoded in another, and
+/// the view takes decoded frames in GUI thread. Every stage hands frames to the next through a FrameMailbox, so
+/// a stage that falls behind skips to the newest frame and the picture is never more than one frame behind the
+/// newest one received. Frames are decoded at the smallest size the JPEG decoder can scale to in DCT domain which
+/// still fills the size the video is shown at.
+class MjpegStreamClient : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(MjpegStreamClient)
+
+public:
+	enum class State {
+		idle
+		, connecting
+		, streaming
+		, failed
+	};
+
+	/// Creates client and starts its threads
+	explicit MjpegStreamClient(QObject *parent = nullptr);
+
+	/// Stops the threads, the stream is closed
+	~MjpegStreamClient() override;
+
+	/// Requests stream from mjpg-streamer at given address, closing the current one
+	void start(const QString &host, quint16 port);
+
+	/// Closes the stream
+	void stop();
+
+	State state() const;
+
+	/// Takes the newest decoded frame, if it was not taken yet, and accounts its age. Shall be called right before
+	/// the frame is painted.
+	bool takeFrame(QImage &frame);
+
+	/// Number of frames received, decoded and taken to be shown. Safe to call from any thread.
+	qint64 receivedFrames() const;
+	qint64 decodedFrames() const;
+	qint64 presentedFrames() const;
+
+	/// Number of frames dropped since newer ones came before they were decoded or taken. Safe to call from any
+	/// thread.
+	qint64 droppedBeforeDecoding() const;
+	qint64 droppedBeforePresenting() const;
+
+	/// Sets size in device pixels the video is shown at, frames are decoded no larger than needed to fill it.
+	/// Empty size decodes frames in full.
+	void setTargetSize(const QSize &size);
+
+	/// Largest JPEG scale denominator (1, 2, 4 or 8) whose image still covers target fitted into frame size with
+	/// aspect ratio kept
+	static int decodeScale(const QSize &frameSize, const QSize &targetSize);
+
+signals:
+	void stateChanged(MjpegStreamClient::State state);
+
+	/// A decoded frame waits to be taken by takeFrame(). Emitted once however many frames replace each other
+	/// before that.
+	void frameReady();
+
+	/// Emitted about once a second while frames are decoded
+	void statisticsChanged(const VideoStatistics &statistics);
+
+private:
+	friend class MjpegReceiver;
+	friend class MjpegDecoder;
+
+	/// JPEG frame handed from receiving to decoding
+	struct EncodedFrame {
+		QByteArray jpeg;
+		qint64 receivedAt {};
+		int stream {};
+	};
+
+	/// Image handed from decoding to presenting
+	struct DecodedFrame {
+		QImage image;
+		qint64 receivedAt {};
+		int stream {};
+	};
+
+	/// Monotonic time in microseconds, comparable between threads
+	static qint64 now();
+
+	/// Applies state change reported by the receiver for given stream, older streams are ignored
+	void setState(State state, int stream);
+
+	/// Completes statistics of decoding with what was shown and emits them
+	void reportStatistics(VideoStatistics statistics);
+
+	QThread mReceiverThread;
+	QThread mDecoderThread;
+	MjpegReceiver *mReceiver {}; // Ownership is passed to the thread
+	MjpegDecoder *mDecoder {}; // Ownership is passed to the thread
+
+	/// Number of the current stream, changes on every start() and stop()
+	int mStream {};
+	State mState { State::idle };
+
+	FrameMailbox<EncodedFrame> mEncoded;
+	FrameMailbox<DecodedFrame> mDecoded;
+
+	std::atomic<qint64> mReceivedCount { 0 };
+	std::atomic<qint64> mDecodedCount { 0 };
+	std::atomic<qint64> mPresentedCount { 0 };
+
+	/// Frames of one read from the socket that were not the newest one
+	std::atomic<qint64> mSkippedCount { 0 };
+
+	/// Ages of frames taken since statistics were reported last, GUI thread only
+	int mAgeSamples {};
+	qint64 mAgeSum {};
+	qint64 mAgeMax {};
+};
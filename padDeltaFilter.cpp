@@ -0,0 +1,115 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "padDeltaFilter.h"
+
+constexpr int PadDeltaFilter::defaultRefreshInterval;
+
+PadDeltaFilter::PadDeltaFilter(QObject *parent)
+	: QObject(parent)
+	, mRefreshTimer(this)
+{
+	mClock.start();
+	connect(&mRefreshTimer, &QTimer::timeout, this, &PadDeltaFilter::refresh);
+}
+
+void PadDeltaFilter::setRefreshInterval(int interval)
+{
+	mRefreshInterval = qMax(0, interval);
+	updateRefreshTimer();
+}
+
+void PadDeltaFilter::reset()
+{
+	mPads = {};
+	updateRefreshTimer();
+}
+
+qint64 PadDeltaFilter::sentPads() const
+{
+	return mSent;
+}
+
+qint64 PadDeltaFilter::suppressedPads() const
+{
+	return mSuppressed;
+}
+
+void PadDeltaFilter::process(const CommandFrame &frame)
+{
+	const qint64 now = mClock.elapsed();
+	CommandFrame result;
+	for (const auto &command : frame) {
+		const bool isPad = command.type == GamepadCommand::Type::pad;
+		const bool isKnownPad = (isPad || command.type == GamepadCommand::Type::padUp)
+				&& command.id >= 1 && command.id <= static_cast<int>(mPads.size());
+		if (isKnownPad) {
+			auto &pad = mPads[command.id - 1u];
+			if (!isPad) {
+				pad.held = false;
+			} else if (mRefreshInterval > 0 && pad.held && pad.x == command.x && pad.y == command.y
+					&& now - pad.sentAt < mRefreshInterval) {
+				++mSuppressed;
+				continue;
+			} else {
+				pad.held = true;
+				pad.x = command.x;
+				pad.y = command.y;
+				pad.sentAt = now;
+				++mSent;
+			}
+		} else if (isPad) {
+			++mSent;
+		}
+
+		result.append(command);
+	}
+
+	updateRefreshTimer();
+	if (!result.isEmpty()) {
+		Q_EMIT framePrepared(result);
+	}
+}
+
+void PadDeltaFilter::refresh()
+{
+	const qint64 now = mClock.elapsed();
+	CommandFrame result;
+	for (size_t i = 0; i < mPads.size(); ++i) {
+		auto &pad = mPads[i];
+		if (pad.held && now - pad.sentAt >= mRefreshInterval) {
+			result.append(GamepadCommand::pad(static_cast<int>(i) + 1, pad.x, pad.y));
+			pad.sentAt = now;
+			++mSent;
+		}
+	}
+
+	if (!result.isEmpty()) {
+		Q_EMIT framePrepared(result);
+	}
+}
+
+void PadDeltaFilter::updateRefreshTimer()
+{
+	const bool someHeld = mPads[0].held || mPads[1].held;
+	if (mRefreshInterval > 0 && someHeld) {
+		// Checking twice per interval keeps a silent pad refreshed at most half an interval late
+		const int period = qMax(1, mRefreshInterval / 2);
+		if (!mRefreshTimer.isActive() || mRefreshTimer.interval() != period) {
+			mRefreshTimer.start(period);
+		}
+	} else {
+		mRefreshTimer.stop();
+	}
+}
@@ -0,0 +1,84 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+#include <array>
+#include <atomic>
+
+#include "commandFrame.h"
+
+/// Stage between a strategy and the network which sends pad positions only when they change. A pad command
+/// repeating the position last sent for the pad is dropped, unless the position was not sent for refresh interval.
+/// Pads that stay pressed are re-sent every refresh interval even if the strategy is silent, so the robot does not
+/// take a lost command for a stopped gamepad. Pad releases and all other commands always pass.
+class PadDeltaFilter : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(PadDeltaFilter)
+
+public:
+	/// Default refresh interval, in ms
+	static constexpr int defaultRefreshInterval = 500;
+
+	explicit PadDeltaFilter(QObject *parent = nullptr);
+
+	/// Sets refresh interval in ms, 0 disables the filter so every command passes
+	void setRefreshInterval(int interval);
+
+	/// Forgets positions sent, so the next command of every pad passes
+	void reset();
+
+	/// Number of pad position commands passed, including refreshes. Safe to read from any thread.
+	qint64 sentPads() const;
+
+	/// Number of pad position commands dropped as unchanged. Safe to read from any thread.
+	qint64 suppressedPads() const;
+
+public slots:
+	/// Drops redundant pad commands from the frame and emits the rest
+	void process(const CommandFrame &frame);
+
+signals:
+	/// Frame to send, never empty
+	void framePrepared(const CommandFrame &frame);
+
+private:
+	/// Last position sent for a pad
+	struct Pad {
+		bool held {};
+		qint8 x {};
+		qint8 y {};
+		qint64 sentAt {};
+	};
+
+	/// Re-sends positions of pressed pads which were not sent for refresh interval
+	void refresh();
+
+	/// Runs refresh timer while some pad is pressed
+	void updateRefreshTimer();
+
+	std::array<Pad, 2> mPads {};
+	int mRefreshInterval { defaultRefreshInterval };
+
+	QElapsedTimer mClock;
+	QTimer mRefreshTimer; // Child, so it follows the filter to another thread
+
+	std::atomic<qint64> mSent { 0 };
+	std::atomic<qint64> mSuppressed { 0 };
+};
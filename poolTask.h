@@ -0,0 +1,38 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QRunnable>
+
+#include <functional>
+#include <utility>
+
+/// Task of QThreadPool running given function, for Qt versions whose pool does not take functions itself
+class PoolTask : public QRunnable
+{
+public:
+	explicit PoolTask(std::function<void()> work)
+		: mWork(std::move(work))
+	{
+	}
+
+	void run() override
+	{
+		mWork();
+	}
+
+private:
+	std::function<void()> mWork;
+};
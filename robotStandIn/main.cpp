@@ -0,0 +1,59 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/* Stand-in for the gamepad server of TRIK robot, so the gamepad can be tested and benchmarked on one machine:
+ *     robotStandIn --port 4444 &
+ *     gamepad --headless --script drive.txt 127.0.0.1
+ * Every received command is logged as "<microseconds since start> <peer> <transport> #<sequence> <command>". */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+
+#include "robotStandIn.h"
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Stand-in for the gamepad server of TRIK robot.");
+	parser.addHelpOption();
+	parser.addOption({"port", "Port for TCP connections and UDP datagrams.", "port", "4444"});
+	parser.addOption({"log", "Log file, stdout if omitted.", "file"});
+	parser.addOption({"binary", "Accept binary protocol negotiation."});
+	parser.addOption({"no-echo", "Do not answer pings, like old robots."});
+	parser.addOption({"read-delay", "Pause before reading arrived data, ms.", "ms", "0"});
+	parser.addOption({"read-buffer", "Receive buffer size of a connection, bytes.", "bytes", "0"});
+	parser.addOption({"disconnect-after", "Drop connection after given number of commands.", "count", "0"});
+	parser.addOption({"disconnect-every", "Drop all connections periodically, ms.", "ms", "0"});
+	parser.addOption({"stall-after", "Stop reading and answering after given time, ms.", "ms", "0"});
+	parser.process(application);
+
+	StandInOptions options;
+	options.port = static_cast<quint16>(parser.value("port").toUInt());
+	options.binary = parser.isSet("binary");
+	options.echo = !parser.isSet("no-echo");
+	options.readDelay = parser.value("read-delay").toInt();
+	options.readBufferSize = parser.value("read-buffer").toInt();
+	options.disconnectAfter = parser.value("disconnect-after").toInt();
+	options.disconnectEvery = parser.value("disconnect-every").toInt();
+	options.stallAfter = parser.value("stall-after").toInt();
+
+	RobotStandIn standIn(options, parser.value("log"));
+	if (!standIn.start()) {
+		return 1;
+	}
+
+	return application.exec();
+}
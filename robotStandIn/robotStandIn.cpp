@@ -0,0 +1,127 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "robotStandIn.h"
+
+#include <QtCore/QDebug>
+#include <QtNetwork/QNetworkDatagram>
+
+#include "commandCodec.h"
+#include "standInSession.h"
+
+RobotStandIn::RobotStandIn(const StandInOptions &options, const QString &logFileName, QObject *parent)
+	: QObject(parent)
+	, mOptions(options)
+	, mLogFile(logFileName)
+{
+	connect(&mServer, &QTcpServer::newConnection, this, &RobotStandIn::onNewConnection);
+	connect(&mUdpSocket, &QUdpSocket::readyRead, this, &RobotStandIn::onDatagrams);
+	connect(&mDisconnectTimer, &QTimer::timeout, this, &RobotStandIn::disconnectAll);
+}
+
+bool RobotStandIn::start()
+{
+	if (mLogFile.fileName().isEmpty()) {
+		mLogFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+	} else if (!mLogFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		qCritical().noquote() << "Can not open log" << mLogFile.fileName() << ":" << mLogFile.errorString();
+		return false;
+	}
+
+	mLog.setDevice(&mLogFile);
+
+	if (!mServer.listen(QHostAddress::Any, mOptions.port)) {
+		qCritical().noquote() << "Can not listen on port" << mOptions.port << ":" << mServer.errorString();
+		return false;
+	}
+
+	if (!mUdpSocket.bind(QHostAddress::Any, mOptions.port)) {
+		qCritical().noquote() << "Can not bind UDP port" << mOptions.port << ":" << mUdpSocket.errorString();
+		return false;
+	}
+
+	if (mOptions.disconnectEvery > 0) {
+		mDisconnectTimer.start(mOptions.disconnectEvery);
+	}
+
+	mClock.start();
+	log("stand-in", QString("listening on port %1").arg(mOptions.port));
+	return true;
+}
+
+const StandInOptions &RobotStandIn::options() const
+{
+	return mOptions;
+}
+
+qint64 RobotStandIn::now() const
+{
+	return mClock.nsecsElapsed() / 1000;
+}
+
+void RobotStandIn::log(const QString &peer, const QString &message)
+{
+	mLog << now() << ' ' << peer << ' ' << message << '\n';
+	mLog.flush();
+}
+
+void RobotStandIn::logCommand(const QString &peer, const char *transport, const GamepadCommand &command)
+{
+	if (command.type == GamepadCommand::Type::invalid) {
+		log(peer, QString("%1 malformed command").arg(transport));
+		return;
+	}
+
+	QByteArray text;
+	CommandCodec().encode(command, text);
+	log(peer, QString("%1 #%2 %3").arg(transport).arg(command.sequence).arg(QString::fromLatin1(text.trimmed())));
+}
+
+void RobotStandIn::onNewConnection()
+{
+	while (auto socket = mServer.nextPendingConnection()) {
+		new StandInSession(socket, this);
+	}
+}
+
+void RobotStandIn::onDatagrams()
+{
+	while (mUdpSocket.hasPendingDatagrams()) {
+		const auto &datagram = mUdpSocket.receiveDatagram();
+		const auto &data = datagram.data();
+		const auto &peer = QString("%1:%2").arg(datagram.senderAddress().toString()).arg(datagram.senderPort());
+		int position = 0;
+		GamepadCommand command;
+		while (const int consumed = CommandCodec::decode(data.constData() + position, data.size() - position
+				, command)) {
+			position += consumed;
+			// Pads are latest-wins, late datagram carrying older position is ignored, see README
+			const qint16 age = static_cast<qint16>(command.sequence - mLastDatagramSequence);
+			if (mLastDatagramSequence >= 0 && age <= 0) {
+				log(peer, QString("udp #%1 stale, ignored").arg(command.sequence));
+				continue;
+			}
+
+			mLastDatagramSequence = command.sequence;
+			logCommand(peer, "udp", command);
+		}
+	}
+}
+
+void RobotStandIn::disconnectAll()
+{
+	for (auto session : findChildren<StandInSession *>(QString(), Qt::FindDirectChildrenOnly)) {
+		session->drop();
+	}
+}
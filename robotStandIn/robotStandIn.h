@@ -0,0 +1,102 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QUdpSocket>
+
+#include "gamepadCommand.h"
+
+class StandInSession;
+
+/// Behaviour of the stand-in, mostly ways to misbehave like a robot on a bad link
+struct StandInOptions
+{
+	/// Port for TCP connections and UDP datagrams
+	quint16 port { 4444 };
+
+	/// Answer "protocol 1" and switch to binary protocol
+	bool binary {};
+
+	/// Answer pings, robots with old runtime do not
+	bool echo { true };
+
+	/// Pause before reading data which has arrived, in ms, so the gamepad sees a slow reader
+	int readDelay {};
+
+	/// Size of receive buffer of a connection in bytes, 0 is unlimited. Small buffer with read delay makes
+	/// the link congested.
+	int readBufferSize {};
+
+	/// Drop connection after receiving given number of commands, 0 is never
+	int disconnectAfter {};
+
+	/// Drop all connections with given period in ms, 0 is never
+	int disconnectEvery {};
+
+	/// Stop reading and answering (but keep connection open) after given time in ms, 0 is never
+	int stallAfter {};
+};
+
+/// Stand-in for the gamepad server of TRIK robot. Accepts connections on the gamepad port, logs every received
+/// command with timestamp, answers pings and protocol negotiation and watches keepalive timeout like the robot does.
+class RobotStandIn : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(RobotStandIn)
+
+public:
+	/// Creates stand-in which logs to given file or stdout if the name is empty
+	explicit RobotStandIn(const StandInOptions &options, const QString &logFileName = QString()
+			, QObject *parent = nullptr);
+
+	/// Starts listening, returns false if the port is busy or the log can not be opened
+	bool start();
+
+	/// Options of the stand-in
+	const StandInOptions &options() const;
+
+	/// Time since start in microseconds, used for all timestamps
+	qint64 now() const;
+
+	/// Writes timestamped line to the log
+	void log(const QString &peer, const QString &message);
+
+	/// Writes timestamped received command to the log
+	void logCommand(const QString &peer, const char *transport, const GamepadCommand &command);
+
+private slots:
+	void onNewConnection();
+	void onDatagrams();
+	void disconnectAll();
+
+private:
+	StandInOptions mOptions;
+	QTcpServer mServer;
+	QUdpSocket mUdpSocket;
+	QTimer mDisconnectTimer;
+	QElapsedTimer mClock;
+
+	QFile mLogFile;
+	QTextStream mLog;
+
+	/// Last sequence number of pad datagrams, -1 before the first one
+	int mLastDatagramSequence { -1 };
+};
@@ -0,0 +1,41 @@
+# Copyright 2026 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Stand-in for the gamepad server of TRIK robot, for testing gamepad without hardware
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic -Wold-style-cast -Wconversion
+QMAKE_CXXFLAGS += -Winit-self -Wunreachable-code
+QMAKE_CXXFLAGS += -Werror -Wno-conversion
+QMAKE_CXXFLAGS += -Wno-error=deprecated-declarations
+QMAKE_CXXFLAGS += -isystem "$$[QT_INSTALL_HEADERS]"
+
+QT = core network
+CONFIG += console c++14
+CONFIG -= app_bundle
+TARGET = robotStandIn
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+	$$PWD/main.cpp \
+	$$PWD/robotStandIn.cpp \
+	$$PWD/standInSession.cpp \
+	$$PWD/../commandCodec.cpp
+
+HEADERS += \
+	$$PWD/robotStandIn.h \
+	$$PWD/standInSession.h \
+	$$PWD/../gamepadCommand.h \
+	$$PWD/../commandCodec.h
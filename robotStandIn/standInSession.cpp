@@ -0,0 +1,151 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "standInSession.h"
+
+#include "robotStandIn.h"
+
+StandInSession::StandInSession(QTcpSocket *socket, RobotStandIn *standIn)
+	: QObject(standIn)
+	, mSocket(socket)
+	, mStandIn(standIn)
+	, mPeer(QString("%1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort()))
+{
+	mSocket->setParent(this);
+	const auto &options = mStandIn->options();
+	if (options.readBufferSize > 0) {
+		mSocket->setReadBufferSize(options.readBufferSize);
+	}
+
+	mReadTimer.setSingleShot(true);
+	mKeepaliveTimer.setSingleShot(true);
+	connect(&mReadTimer, &QTimer::timeout, this, &StandInSession::readCommands);
+	connect(&mKeepaliveTimer, &QTimer::timeout, this, &StandInSession::onKeepaliveExpired);
+	connect(mSocket, &QTcpSocket::readyRead, this, &StandInSession::onReadyRead);
+	connect(mSocket, &QTcpSocket::disconnected, this, &StandInSession::onDisconnected);
+
+	if (options.stallAfter > 0) {
+		QTimer::singleShot(options.stallAfter, this, [this]() {
+			mStalled = true;
+			mReadTimer.stop();
+			mStandIn->log(mPeer, "stalled, nothing is read or answered any more");
+		});
+	}
+
+	mStandIn->log(mPeer, "connected");
+}
+
+void StandInSession::drop()
+{
+	mStandIn->log(mPeer, "dropping connection");
+	mSocket->abort();
+	deleteLater();
+}
+
+void StandInSession::onReadyRead()
+{
+	if (mStalled || mReadTimer.isActive()) {
+		return;
+	}
+
+	if (mStandIn->options().readDelay > 0) {
+		mReadTimer.start(mStandIn->options().readDelay);
+	} else {
+		readCommands();
+	}
+}
+
+void StandInSession::readCommands()
+{
+	if (mStalled) {
+		return;
+	}
+
+	mInBuffer.append(mSocket->readAll());
+	int position = 0;
+	GamepadCommand command;
+	while (const int consumed = CommandCodec::decode(mInBuffer.constData() + position
+			, mInBuffer.size() - position, command)) {
+		position += consumed;
+		handle(command);
+		if (mSocket->state() != QAbstractSocket::ConnectedState) {
+			return;
+		}
+	}
+
+	mInBuffer.remove(0, position);
+
+	if (!mOutBuffer.isEmpty()) {
+		mSocket->write(mOutBuffer);
+		mOutBuffer.clear();
+	}
+
+	// Data which arrived during the delay is read by the next round
+	if (mSocket->bytesAvailable() > 0) {
+		onReadyRead();
+	}
+}
+
+void StandInSession::handle(const GamepadCommand &command)
+{
+	mStandIn->logCommand(mPeer, "tcp", command);
+
+	// Like the robot, any data keeps motors running until keepalive timeout is over
+	if (mKeepaliveTimer.isActive()) {
+		mKeepaliveTimer.start();
+	}
+
+	const auto &options = mStandIn->options();
+	switch (command.type) {
+	case GamepadCommand::Type::keepalive:
+		mKeepaliveTimer.start(command.value);
+		break;
+	case GamepadCommand::Type::protocol:
+		if (options.binary && command.value == CommandCodec::binaryProtocolVersion) {
+			reply(command);
+			mCodec.setProtocol(CommandCodec::Protocol::binary);
+		}
+
+		break;
+	case GamepadCommand::Type::ping:
+		if (options.echo) {
+			reply(GamepadCommand::echo(command.value));
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	++mCommands;
+	if (options.disconnectAfter > 0 && mCommands == options.disconnectAfter) {
+		drop();
+	}
+}
+
+void StandInSession::reply(const GamepadCommand &command)
+{
+	mCodec.encode(command, mOutBuffer);
+}
+
+void StandInSession::onKeepaliveExpired()
+{
+	mStandIn->log(mPeer, "keepalive timeout is over, motors stopped");
+}
+
+void StandInSession::onDisconnected()
+{
+	mStandIn->log(mPeer, QString("disconnected after %1 commands").arg(mCommands));
+	deleteLater();
+}
@@ -0,0 +1,68 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QTcpSocket>
+
+#include "commandCodec.h"
+
+class RobotStandIn;
+
+/// Connection of one gamepad to the stand-in. Deletes itself when the gamepad disconnects.
+class StandInSession : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(StandInSession)
+
+public:
+	/// Takes ownership of the socket
+	StandInSession(QTcpSocket *socket, RobotStandIn *standIn);
+
+	/// Drops the connection like a robot that was switched off
+	void drop();
+
+private slots:
+	void onReadyRead();
+	void readCommands();
+	void onKeepaliveExpired();
+	void onDisconnected();
+
+private:
+	void handle(const GamepadCommand &command);
+	void reply(const GamepadCommand &command);
+
+	QTcpSocket *mSocket; // Has ownership (QObject child)
+	RobotStandIn *mStandIn; // Doesn't have ownership
+
+	/// Peer address for the log
+	QString mPeer;
+
+	/// Codec for replies, switched to binary after negotiation
+	CommandCodec mCodec;
+
+	QByteArray mInBuffer;
+	QByteArray mOutBuffer;
+
+	/// Delays reading to simulate slow robot
+	QTimer mReadTimer;
+
+	/// Robot stops motors when no data arrives during keepalive timeout
+	QTimer mKeepaliveTimer;
+
+	int mCommands {};
+	bool mStalled {};
+};
@@ -0,0 +1,93 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "screenshotWorker.h"
+
+#include <QtCore/QBuffer>
+#ifdef TRIK_USE_QT6
+	#include <QtMultimedia/QVideoFrameFormat>
+#endif
+
+#include "frameConverter.h"
+#include "poolTask.h"
+
+ScreenshotWorker::ScreenshotWorker(QObject *parent)
+	: QObject(parent)
+{
+}
+
+ScreenshotWorker::~ScreenshotWorker()
+{
+	mPool.waitForDone();
+}
+
+bool ScreenshotWorker::take(const QVideoFrame &frame)
+{
+	if (mBusy.exchange(true)) {
+		return false;
+	}
+
+	mPool.start(new PoolTask([this, frame]() { deliver(convert(frame)); }));
+	return true;
+}
+
+bool ScreenshotWorker::take(const QImage &image)
+{
+	if (mBusy.exchange(true)) {
+		return false;
+	}
+
+	mPool.start(new PoolTask([this, image]() { deliver(image); }));
+	return true;
+}
+
+void ScreenshotWorker::deliver(const QImage &image)
+{
+	QByteArray png;
+	if (!image.isNull()) {
+		QBuffer buffer(&png);
+		buffer.open(QIODevice::WriteOnly);
+		image.save(&buffer, "PNG");
+	}
+
+	mBusy = false;
+	QMetaObject::invokeMethod(this, [this, image, png]() { Q_EMIT imageReady(image, png); }, Qt::QueuedConnection);
+}
+
+QImage ScreenshotWorker::convert(QVideoFrame frame)
+{
+#ifdef TRIK_USE_QT6
+	frame.map(QVideoFrame::ReadOnly);
+	const QImage::Format imageFormat = QVideoFrameFormat::imageFormatFromPixelFormat(frame.pixelFormat());
+#else
+	frame.map(QAbstractVideoBuffer::ReadOnly);
+	const QImage::Format imageFormat = QVideoFrame::imageFormatFromPixelFormat(frame.pixelFormat());
+#endif
+	QImage image;
+	YuvImage yuv;
+	// check whether videoframe can be transformed to qimage by qt
+	if (imageFormat != QImage::Format_Invalid) {
+#ifdef TRIK_USE_QT6
+		image = frame.toImage();
+#else
+		// Rows may be padded, and the image must outlive the mapping of the frame
+		image = QImage(frame.bits(), frame.width(), frame.height(), frame.bytesPerLine(), imageFormat).copy();
+#endif
+	} else if (FrameConverter::describe(frame, yuv)) {
+		image = FrameConverter::toImage(yuv, &mPool);
+	}
+
+	frame.unmap();
+	return image;
+}
@@ -0,0 +1,59 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QThreadPool>
+#include <QtGui/QImage>
+#include <QVideoFrame>
+
+#include <atomic>
+
+/// Turns video frames into screenshots away from GUI thread, so keys and control buttons stay responsive while
+/// a frame is converted and encoded. YUV frames are converted by FrameConverter in bands of rows spread over
+/// the threads of a private pool, then the image is encoded to PNG there as well, since clipboard consumers
+/// mostly ask for PNG and Qt would encode it in GUI thread on demand.
+class ScreenshotWorker : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(ScreenshotWorker)
+
+public:
+	explicit ScreenshotWorker(QObject *parent = nullptr);
+
+	/// Waits for the screenshot in progress, its result is dropped
+	~ScreenshotWorker() override;
+
+	/// Starts making screenshot of the frame. Returns false and does nothing if the previous one is not ready yet.
+	bool take(const QVideoFrame &frame);
+
+	/// Starts making screenshot of a decoded image, only PNG encoding is left to do. Returns false and does
+	/// nothing if the previous one is not ready yet.
+	bool take(const QImage &image);
+
+signals:
+	/// Screenshot is ready, emitted in the thread of the worker. Image is null if frame format is not supported.
+	void imageReady(const QImage &image, const QByteArray &png);
+
+private:
+	/// Maps frame and converts it to image, in a thread of the pool
+	QImage convert(QVideoFrame frame);
+
+	/// Encodes image to PNG and emits imageReady, in a thread of the pool
+	void deliver(const QImage &image);
+
+	QThreadPool mPool;
+	std::atomic<bool> mBusy { false };
+};
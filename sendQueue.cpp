@@ -0,0 +1,114 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "sendQueue.h"
+
+void SendQueue::enqueue(const CommandFrame &frame)
+{
+	for (const auto &command : frame) {
+		const bool isPad = command.type == GamepadCommand::Type::pad || command.type == GamepadCommand::Type::padUp;
+		if (isPad && command.id >= 1 && command.id <= padCount) {
+			auto &index = mPads[static_cast<size_t>(command.id - 1)];
+			if (index >= 0) {
+				++mDropped;
+			}
+
+			replace(command, index);
+		} else if (command.type == GamepadCommand::Type::keepalive) {
+			replace(command, mKeepalive);
+		} else if (command.type == GamepadCommand::Type::ping || command.type == GamepadCommand::Type::invalid) {
+			continue;
+		} else if (mReliable < maxReliable) {
+			mCommands.append(command);
+			++mReliable;
+			++mSize;
+		} else {
+			++mDropped;
+		}
+	}
+}
+
+void SendQueue::replace(const GamepadCommand &command, int &index)
+{
+	if (index >= 0) {
+		mCommands[index].type = GamepadCommand::Type::invalid;
+	} else {
+		++mSize;
+	}
+
+	// Pads are replaced every control tick while the link is stuck, so replaced commands are not kept for long
+	if (mCommands.size() - mSize > maxReliable) {
+		compact();
+	}
+
+	index = mCommands.size();
+	mCommands.append(command);
+}
+
+void SendQueue::compact()
+{
+	int kept = 0;
+	for (int i = 0; i < mCommands.size(); ++i) {
+		if (mCommands[i].type == GamepadCommand::Type::invalid) {
+			continue;
+		}
+
+		for (auto &index : mPads) {
+			index = index == i ? kept : index;
+		}
+
+		mKeepalive = mKeepalive == i ? kept : mKeepalive;
+		mCommands[kept++] = mCommands[i];
+	}
+
+	mCommands.resize(kept);
+}
+
+QVector<GamepadCommand> SendQueue::takeAll()
+{
+	QVector<GamepadCommand> result;
+	result.reserve(mSize);
+	for (const auto &command : mCommands) {
+		if (command.type != GamepadCommand::Type::invalid) {
+			result.append(command);
+		}
+	}
+
+	clear();
+	return result;
+}
+
+void SendQueue::clear()
+{
+	mCommands.clear();
+	mPads.fill(-1);
+	mKeepalive = -1;
+	mReliable = 0;
+	mSize = 0;
+}
+
+int SendQueue::size() const
+{
+	return mSize;
+}
+
+bool SendQueue::isEmpty() const
+{
+	return mSize == 0;
+}
+
+int SendQueue::dropped() const
+{
+	return mDropped;
+}
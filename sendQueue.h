@@ -0,0 +1,77 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QVector>
+
+#include <array>
+
+#include "commandFrame.h"
+
+/// Commands waiting for a congested link to drain. Only the newest position of each pad and the newest keepalive are
+/// kept, since older ones are useless for the robot by the time they arrive. Buttons and service commands are kept,
+/// unless maxReliable of them are waiting already. Probes are not queued at all: their send time would be wrong.
+/// Commands leave the queue in the order they came, a replaced command takes the place of its newest version.
+class SendQueue
+{
+public:
+	/// Number of pads which have their own latest-wins slot
+	static constexpr int padCount = 2;
+
+	/// Maximal number of buttons and service commands kept, further ones are dropped
+	static constexpr int maxReliable = 256;
+
+	/// Puts commands of the frame into the queue, replacing queued positions of the same pads and queued keepalive
+	void enqueue(const CommandFrame &frame);
+
+	/// Removes all queued commands and returns them in sending order
+	QVector<GamepadCommand> takeAll();
+
+	/// Drops everything
+	void clear();
+
+	/// Number of queued commands
+	int size() const;
+
+	/// Returns true if nothing is queued
+	bool isEmpty() const;
+
+	/// Total number of commands lost: pad positions replaced by newer ones and commands that did not fit
+	int dropped() const;
+
+private:
+	/// Appends command, replacing the one at given index. Index is updated to the new place of the command.
+	void replace(const GamepadCommand &command, int &index);
+
+	/// Removes replaced commands from mCommands
+	void compact();
+
+	/// Commands in arrival order, replaced ones are left as Type::invalid until takeAll()
+	QVector<GamepadCommand> mCommands;
+
+	/// Index in mCommands of queued position of each pad, -1 if there is none
+	std::array<int, padCount> mPads {{ -1, -1 }};
+
+	/// Index in mCommands of queued keepalive, -1 if there is none
+	int mKeepalive { -1 };
+
+	/// Number of queued buttons and service commands
+	int mReliable {};
+
+	/// Number of queued commands
+	int mSize {};
+
+	int mDropped {};
+};
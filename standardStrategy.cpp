@@ -17,6 +17,33 @@
 
 #include "standardStrategy.h"
 
+namespace {
+
+/// Pad coordinates contributed by a pressed key
+struct PadAction {
+	int x;
+	int y;
+};
+
+/// Contribution of every control key, indexed by ControlKeys::Id. Magic buttons do not move pads.
+constexpr PadAction padActions[ControlKeys::count] = {
+	{0, 100} // W
+	, {-100, 0} // A
+	, {0, -100} // S
+	, {100, 0} // D
+	, {-100, 0} // Left
+	, {0, 100} // Up
+	, {100, 0} // Right
+	, {0, -100} // Down
+	, {0, 0}
+	, {0, 0}
+	, {0, 0}
+	, {0, 0}
+	, {0, 0}
+};
+
+}
+
 StandardStrategy::StandardStrategy(QObject *parent)
 	: Strategy(parent)
 {
@@ -25,55 +52,66 @@ StandardStrategy::StandardStrategy(QObject *parent)
 
 void StandardStrategy::processEvent(QEvent *event)
 {
-	int resultingPowerX1 = 0;
-	int resultingPowerY1 = 0;
-	int resultingPowerX2 = 0;
-	int resultingPowerY2 = 0;
-
-	if (event->type() == QKeyEvent::KeyPress) {
-		auto key = (dynamic_cast<QKeyEvent *> (event))->key();
-		mPressedKeys += key;
-		// Handle W A S D buttons
-		resultingPowerX1 = (mPressedKeys.contains(Qt::Key_D) ? 100 : 0) + (mPressedKeys.contains(Qt::Key_A) ? -100 : 0);
-		resultingPowerY1 = (mPressedKeys.contains(Qt::Key_S) ? -100 : 0) + (mPressedKeys.contains(Qt::Key_W) ? 100 : 0);
-		// Handle arrow buttons
-		resultingPowerX2 = (mPressedKeys.contains(Qt::Key_Right) ? 100 : 0)
-				+ (mPressedKeys.contains(Qt::Key_Left) ? -100 : 0);
-		resultingPowerY2 = (mPressedKeys.contains(Qt::Key_Down) ? -100 : 0)
-				+ (mPressedKeys.contains(Qt::Key_Up) ? 100 : 0);
-
-		if (resultingPowerX1 != 0 || resultingPowerY1 != 0) {
-			Q_EMIT commandPrepared(QString("pad 1 %1 %2 \n").arg(resultingPowerX1).arg(resultingPowerY1));
-		} else if (resultingPowerX2 != 0 || resultingPowerY2 != 0) {
-			Q_EMIT commandPrepared(QString("pad 2 %1 %2 \n").arg(resultingPowerX2).arg(resultingPowerY2));
+	const auto type = event->type();
+	if (type != QEvent::KeyPress && type != QEvent::KeyRelease) {
+		return;
+	}
+
+	const auto id = ControlKeys::idOf(static_cast<QKeyEvent *>(event)->key());
+	if (type == QEvent::KeyPress) {
+		if (id != ControlKeys::none) {
+			mPressedMask |= ControlKeys::bit(id);
 		}
 
-		// Handle 1 2 3 4 5 buttons
-		QMap<int, int> digits = {
-			{Qt::Key_1, 1}
-			, {Qt::Key_2, 2}
-			, {Qt::Key_3, 3}
-			, {Qt::Key_4, 4}
-			, {Qt::Key_5, 5}
-		};
-
-		for (auto &&key : digits.keys()) {
-			if (mPressedKeys.contains(key)) {
-				Q_EMIT commandPrepared(QString("btn " + QString::number(digits[key]) + "\n"));
+		// Any key press repeats state of all held keys. Both pads go into the same frame, so holding one of them
+		// does not block the other.
+		preparePad(1, ControlKeys::w, ControlKeys::d);
+		preparePad(2, ControlKeys::left, ControlKeys::down);
+		for (int digit = ControlKeys::digit1; digit <= ControlKeys::digit5; ++digit) {
+			if (mPressedMask & ControlKeys::bit(digit)) {
+				prepareCommand(GamepadCommand::button(digit - ControlKeys::digit1 + 1));
 			}
 		}
+	} else if (id != ControlKeys::none) {
+		const auto key = ControlKeys::bit(id);
+		mPressedMask &= static_cast<ControlKeys::Mask>(~key);
+		if (key & ControlKeys::pad1Keys) {
+			prepareCommand(GamepadCommand::padUp(1));
+		} else if (key & ControlKeys::pad2Keys) {
+			prepareCommand(GamepadCommand::padUp(2));
+		}
+	}
+
+	flushFrame();
+}
 
-	} else if (event->type() == QKeyEvent::KeyRelease) {
-		auto key = (dynamic_cast<QKeyEvent *> (event))->key();
-		// Handle key release event
-		QSet<int> pad1 = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
-		QSet<int> pad2 = {Qt::Key_Left, Qt::Key_Right, Qt::Key_Up, Qt::Key_Down};
-		mPressedKeys -= key;
-
-		if (pad1.contains(key)) {
-			Q_EMIT commandPrepared(QString("pad 1 up\n"));
-		} else if (pad2.contains(key)) {
-			Q_EMIT commandPrepared(QString("pad 2 up\n"));
+void StandardStrategy::reset()
+{
+	const auto pressed = mPressedMask;
+	Strategy::reset();
+	if (pressed & ControlKeys::pad1Keys) {
+		prepareCommand(GamepadCommand::padUp(1));
+	}
+
+	if (pressed & ControlKeys::pad2Keys) {
+		prepareCommand(GamepadCommand::padUp(2));
+	}
+
+	flushFrame();
+}
+
+void StandardStrategy::preparePad(int padId, int first, int last)
+{
+	int x = 0;
+	int y = 0;
+	for (int id = first; id <= last; ++id) {
+		if (mPressedMask & ControlKeys::bit(id)) {
+			x += padActions[id].x;
+			y += padActions[id].y;
 		}
 	}
+
+	if (x != 0 || y != 0) {
+		prepareCommand(GamepadCommand::pad(padId, x, y));
+	}
 }
@@ -20,7 +20,8 @@
 #include "strategy.h"
 #include <QtGui/QKeyEvent>
 
-/// class that generates commands from pad only with max/min values
+/// class that generates commands from pad only with max/min values.
+/// Pressed keys are kept in a bitmask and key effects in constant tables, so an event allocates nothing.
 class StandardStrategy : public Strategy
 {
 public:
@@ -28,5 +29,11 @@ public:
 	explicit StandardStrategy(QObject *parent = nullptr);
 	/// method that generates commands
 	void processEvent(QEvent *event) final;
+	/// releases all keys and sends release of pads they held
+	void reset() override;
+
+private:
+	/// Adds command for pad moved by pressed keys with ids from first to last, if they move it
+	void preparePad(int padId, int first, int last);
 };
 
@@ -23,18 +23,89 @@
 // defining static variable
 void Strategy::reset()
 {
-	mPressedKeys.clear();
+	mPressedMask = 0;
 }
 
-Strategy *Strategy::getStrategy(Strategies type, QObject *parent)
+void Strategy::processStick(const GamepadCommand &command)
+{
+	const bool isPad = command.type == GamepadCommand::Type::pad;
+	if ((!isPad && command.type != GamepadCommand::Type::padUp)
+			|| command.id < 1 || command.id > static_cast<int>(mStickHeld.size())) {
+		return;
+	}
+
+	// Release of a stick which does not hold the pad would release the pad held by keys
+	auto &held = mStickHeld[command.id - 1u];
+	if (!isPad && !held) {
+		return;
+	}
+
+	held = isPad;
+	appendCommand(command);
+	flushFrame();
+}
+
+bool Strategy::isStickHeld(int padId) const
+{
+	return padId >= 1 && padId <= static_cast<int>(mStickHeld.size()) && mStickHeld[padId - 1u];
+}
+
+void Strategy::setVirtualClock(bool enabled)
+{
+	mVirtualClock = enabled;
+	mVirtualTime = 0;
+}
+
+void Strategy::advanceClock(qint64 elapsedUs)
+{
+	mVirtualTime += elapsedUs;
+}
+
+qint64 Strategy::virtualTime() const
+{
+	return mVirtualTime;
+}
+
+void Strategy::prepareCommand(const GamepadCommand &command)
+{
+	const bool isPad = command.type == GamepadCommand::Type::pad || command.type == GamepadCommand::Type::padUp;
+	if (isPad && isStickHeld(command.id)) {
+		return;
+	}
+
+	appendCommand(command);
+}
+
+void Strategy::appendCommand(const GamepadCommand &command)
+{
+	if (!mFrame.append(command)) {
+		flushFrame();
+		mFrame.append(command);
+	}
+}
+
+void Strategy::flushFrame()
+{
+	if (!mFrame.isEmpty()) {
+		Q_EMIT framePrepared(mFrame);
+		mFrame.clear();
+	}
+}
+
+Strategy *Strategy::getStrategy(Strategies type, QObject *parent, const QSettings *settings)
 {	
 	switch (type) {
 	case Strategies::standartStrategy:
 		return new StandardStrategy(parent);
 		break;
-	case Strategies::accelerateStrategy:
-		return new AccelerateStrategy(300, parent);
-		break;
+	case Strategies::accelerateStrategy: {
+		auto accelerateStrategy = new AccelerateStrategy(300, parent);
+		if (settings) {
+			accelerateStrategy->loadSettings(*settings);
+		}
+
+		return accelerateStrategy;
+	}
 	default:
 		return nullptr;
 		break;
@@ -21,6 +21,13 @@
 #include <QtGui/QKeyEvent>
 #include <QtCore/QVector>
 
+#include <array>
+
+#include "commandFrame.h"
+#include "controlKeys.h"
+
+class QSettings;
+
 /// is used to get needed instance
 enum class Strategies {
 	standartStrategy = 0
@@ -37,19 +44,55 @@ class Strategy : public QObject
 public:
 	/// method that encapsulates logic for generating commands
 	virtual void processEvent(QEvent *event) = 0;
-	/// method that do all keys not pressed
-	void reset();
+	/// method that do all keys not pressed, pads held by them are released on the robot too. Sticks stay as they are
+	virtual void reset();
 
-	/// method that is used in GUI to get needed instance in run-time
-	static Strategy *getStrategy(Strategies type, QObject *parent);
+	/// method that moves a pad by analog stick, command is pad position or padUp when the stick is back in its
+	/// deadzone. Deflected stick takes the pad over: commands the strategy prepares for it are dropped, so the robot
+	/// gets one position per pad. Once the stick is released keys drive the pad again with their next command
+	void processStick(const GamepadCommand &command);
+	/// returns true if the pad with given number is held by a stick
+	bool isStickHeld(int padId) const;
+
+	/// makes timers of the strategy run on virtual time moved by advanceClock() instead of the wall clock, so
+	/// replayed input gives the same commands on every run. Virtual time starts from 0
+	virtual void setVirtualClock(bool enabled);
+	/// moves virtual time forward by given microseconds, timers due meanwhile fire in their order
+	virtual void advanceClock(qint64 elapsedUs);
+	/// virtual time in microseconds
+	qint64 virtualTime() const;
+
+	/// method that is used in GUI to get needed instance in run-time, settings of the strategy are taken from
+	/// given settings if any
+	static Strategy *getStrategy(Strategies type, QObject *parent, const QSettings *settings = nullptr);
 
 signals:
-	/// signal with generated command
-	void commandPrepared(const QString &command);
+	/// signal with all commands generated during one control tick
+	void framePrepared(const CommandFrame &frame);
 
 protected:
 	explicit Strategy(QObject *parent = nullptr): QObject(parent) {}
-	QSet<int> mPressedKeys;
+
+	/// adds command to the frame of current tick
+	void prepareCommand(const GamepadCommand &command);
+
+	/// emits commands gathered during current tick as one frame
+	void flushFrame();
+
+	/// Pressed control keys
+	ControlKeys::Mask mPressedMask {};
+
+	bool mVirtualClock {};
+	qint64 mVirtualTime {};
+
+private:
+	/// adds command to the frame, flushing the frame if it is full
+	void appendCommand(const GamepadCommand &command);
+
+	CommandFrame mFrame;
+
+	/// Pads held by sticks
+	std::array<bool, 2> mStickHeld {};
 };
 
 
@@ -0,0 +1,222 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "strategyController.h"
+
+#include <QtCore/QDebug>
+
+StrategyController::StrategyController(QObject *parent)
+	: QObject(parent)
+	, mContext(new QObject())
+	, mPadFilter(new PadDeltaFilter())
+{
+	qRegisterMetaType<CommandFrame>();
+	qRegisterMetaType<InputEvent>();
+	mThread.setObjectName("control");
+	mContext->moveToThread(&mThread);
+	mPadFilter->moveToThread(&mThread);
+	connect(&mThread, &QThread::finished, mContext, &QObject::deleteLater);
+	connect(&mThread, &QThread::finished, mPadFilter, &QObject::deleteLater);
+	connect(mPadFilter, &PadDeltaFilter::framePrepared, this, &StrategyController::framePrepared
+			, Qt::DirectConnection);
+	mThread.start(QThread::HighestPriority);
+}
+
+StrategyController::~StrategyController()
+{
+	mThread.quit();
+	mThread.wait();
+	delete mRecorder;
+}
+
+void StrategyController::setStrategy(Strategy *strategy)
+{
+	strategy->moveToThread(&mThread);
+	QMetaObject::invokeMethod(mContext, [this, strategy]() {
+		drain();
+		if (mStrategy) {
+			// Pads of the old strategy must not stay pressed on the robot, accelerate ones would keep driving
+			if (mRecorder) {
+				mRecorder->recordReset();
+			}
+
+			mStrategy->reset();
+		}
+
+		delete mStrategy;
+		mStrategy = strategy;
+		mStrategy->setParent(mContext);
+		mPadFilter->reset();
+		connect(mStrategy, &Strategy::framePrepared, mPadFilter, &PadDeltaFilter::process, Qt::DirectConnection);
+		if (mRecorder) {
+			mRecorder->recordStrategy(*mStrategy);
+		}
+
+		// Sticks are still deflected, the new strategy must know it without waiting for them to move
+		for (const auto &stick : mSticks) {
+			if (stick.type == GamepadCommand::Type::pad) {
+				InputEvent input;
+				input.kind = InputEvent::Kind::stick;
+				input.stick = stick;
+				apply(input);
+			}
+		}
+	}, Qt::QueuedConnection);
+}
+
+void StrategyController::post(const QKeyEvent &event)
+{
+	if (ControlKeys::idOf(event.key()) == ControlKeys::none) {
+		return;
+	}
+
+	InputEvent input;
+	input.autoRepeat = event.isAutoRepeat();
+	input.type = event.type();
+	input.key = event.key();
+	enqueue(mQueue, input);
+}
+
+void StrategyController::reset()
+{
+	InputEvent input;
+	input.kind = InputEvent::Kind::reset;
+	enqueue(mQueue, input);
+}
+
+void StrategyController::postDeviceInput(const InputEvent &event)
+{
+	enqueue(mDeviceQueue, event);
+}
+
+int StrategyController::droppedEvents() const
+{
+	return mDropped;
+}
+
+void StrategyController::setRefreshInterval(int interval)
+{
+	QMetaObject::invokeMethod(mContext, [this, interval]() { mPadFilter->setRefreshInterval(interval); }
+			, Qt::QueuedConnection);
+}
+
+qint64 StrategyController::sentPads() const
+{
+	return mPadFilter->sentPads();
+}
+
+qint64 StrategyController::suppressedPads() const
+{
+	return mPadFilter->suppressedPads();
+}
+
+bool StrategyController::startRecording(const QString &path)
+{
+	auto recorder = new InputRecorder();
+	if (!recorder->open(path)) {
+		qWarning().noquote() << recorder->errorString();
+		delete recorder;
+		return false;
+	}
+
+	QMetaObject::invokeMethod(mContext, [this, recorder]() {
+		delete mRecorder;
+		mRecorder = recorder;
+		if (mStrategy) {
+			mRecorder->recordStrategy(*mStrategy);
+		}
+	}, Qt::QueuedConnection);
+	return true;
+}
+
+void StrategyController::enqueue(InputQueue &queue, const InputEvent &event)
+{
+	auto stamped = event;
+	stamped.sequence = mNextSequence++;
+	if (!queue.push(stamped)) {
+		qWarning() << "Control thread does not keep up, input event dropped, total" << ++mDropped;
+		return;
+	}
+
+	// One wake-up serves all events queued before the control thread gets to it, whichever queue they are in.
+	// The fence pairs with the one in drain(): either the control thread sees the event or this thread sees
+	// the flag cleared.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!mDrainPending.exchange(true)) {
+		QMetaObject::invokeMethod(mContext, [this]() { drain(); }, Qt::QueuedConnection);
+	}
+}
+
+void StrategyController::drain()
+{
+	// Cleared before popping, so an event pushed meanwhile either gets popped now or posts a new wake-up. Without
+	// the fence the load of the queue tail may be satisfied before the store is visible, and an event pushed
+	// meanwhile would be missed while its producer still sees the flag set and skips the wake-up.
+	mDrainPending = false;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Queues are merged by sequence numbers, so a key and a stick moved after it reach the strategy in that order
+	InputEvent input;
+	InputEvent deviceInput;
+	bool hasInput = mQueue.pop(input);
+	bool hasDeviceInput = mDeviceQueue.pop(deviceInput);
+	while (hasInput || hasDeviceInput) {
+		if (hasInput && (!hasDeviceInput || input.sequence < deviceInput.sequence)) {
+			apply(input);
+			hasInput = mQueue.pop(input);
+		} else {
+			apply(deviceInput);
+			hasDeviceInput = mDeviceQueue.pop(deviceInput);
+		}
+	}
+}
+
+void StrategyController::apply(const InputEvent &input)
+{
+	// Sticks are kept even without a strategy, the first one gets them
+	if (input.kind == InputEvent::Kind::stick && input.stick.id >= 1
+			&& input.stick.id <= static_cast<int>(mSticks.size())) {
+		mSticks[input.stick.id - 1u] = input.stick;
+	}
+
+	if (!mStrategy) {
+		return;
+	}
+
+	switch (input.kind) {
+	case InputEvent::Kind::key: {
+		QKeyEvent keyEvent(input.type, input.key, Qt::NoModifier, QString(), input.autoRepeat);
+		if (mRecorder) {
+			mRecorder->recordKey(keyEvent);
+		}
+
+		mStrategy->processEvent(&keyEvent);
+		break;
+	}
+	case InputEvent::Kind::reset:
+		if (mRecorder) {
+			mRecorder->recordReset();
+		}
+
+		mStrategy->reset();
+		break;
+	case InputEvent::Kind::stick:
+		if (mRecorder) {
+			mRecorder->recordStick(input.stick);
+		}
+
+		mStrategy->processStick(input.stick);
+		break;
+	}
+}
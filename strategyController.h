@@ -0,0 +1,114 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtGui/QKeyEvent>
+
+#include <array>
+#include <atomic>
+
+#include "inputQueue.h"
+#include "inputRecorder.h"
+#include "padDeltaFilter.h"
+#include "strategy.h"
+
+/// Runs strategy and its timers in a dedicated control thread, so video rendering or a modal dialog in GUI thread
+/// does not delay pad updates. Input is handed over through lock-free InputQueue, frames pass PadDeltaFilter and
+/// are emitted right in the control thread. All methods but postDeviceInput() are called from the thread which
+/// created the controller.
+class StrategyController : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(StrategyController)
+
+public:
+	/// Creates controller and starts control thread
+	explicit StrategyController(QObject *parent = nullptr);
+
+	/// Stops control thread, current strategy is deleted in it
+	~StrategyController() override;
+
+	/// Hands strategy over to control thread. It shall have no parent and live in this thread. Previous strategy
+	/// processes all input posted before this call and is deleted.
+	void setStrategy(Strategy *strategy);
+
+	/// Queues key event for current strategy. Keys gamepad does not react to are ignored.
+	void post(const QKeyEvent &event);
+
+	/// Queues release of all keys pressed in current strategy
+	void reset();
+
+	/// Queues input of a device read in its own thread, like joystick sticks and buttons. It has a queue of its own,
+	/// so it may be called from one thread other than the one which created the controller. Sticks stay held
+	/// in the next strategy after setStrategy().
+	void postDeviceInput(const InputEvent &event);
+
+	/// Number of input events lost because control thread did not keep up
+	int droppedEvents() const;
+
+	/// Sets how often unchanged positions of pressed pads are re-sent, in ms, 0 sends every pad command
+	void setRefreshInterval(int interval);
+
+	/// Number of pad position commands sent
+	qint64 sentPads() const;
+
+	/// Number of pad position commands not sent since the robot already has the position
+	qint64 suppressedPads() const;
+
+	/// Starts writing input fed to strategies into given file, see InputRecorder. Returns false and prints
+	/// the reason if the file can not be written.
+	bool startRecording(const QString &path);
+
+signals:
+	/// Frame of current strategy, emitted in control thread. Connect with Qt::DirectConnection to a thread-safe
+	/// receiver to send it without any hop through GUI thread.
+	void framePrepared(const CommandFrame &frame);
+
+private:
+	/// Queues event and wakes control thread up if it does not have a wake-up pending already
+	void enqueue(InputQueue &queue, const InputEvent &event);
+
+	/// Feeds queued events of both queues to current strategy in the order they were queued. Control thread only.
+	void drain();
+
+	/// Feeds one event to current strategy and recorder. Control thread only.
+	void apply(const InputEvent &input);
+
+	QThread mThread;
+
+	/// Receiver of calls queued to control thread, parent of current strategy. Deleted when the thread finishes.
+	QObject *mContext {};
+
+	/// Lives in control thread and is deleted when the thread finishes
+	PadDeltaFilter *mPadFilter {};
+
+	Strategy *mStrategy {}; // Doesn't have ownership, accessed in control thread only
+	InputRecorder *mRecorder {}; // Has ownership, accessed in control thread only
+
+	/// Input of the thread which created the controller and of a device thread, each queue has one producer
+	InputQueue mQueue;
+	InputQueue mDeviceQueue;
+
+	/// Last command of every stick, applied again to a new strategy. Accessed in control thread only.
+	std::array<GamepadCommand, 2> mSticks {};
+
+	/// Sequence number for the next queued event
+	std::atomic<quint64> mNextSequence { 0 };
+
+	std::atomic<bool> mDrainPending { false };
+	std::atomic<int> mDropped { 0 };
+};
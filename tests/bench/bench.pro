@@ -0,0 +1,70 @@
+# Copyright 2026 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Benchmarks of gamepad, kept out of the shipped binary. Not a test case, run it by hand or in CI, see main.cpp
+
+include(../tests.pri)
+
+CONFIG -= testcase
+QT = core gui network multimedia
+TARGET = gamepadBench
+
+SOURCES += \
+	$$PWD/main.cpp \
+	$$PWD/controlJitterBenchmark.cpp \
+	$$PWD/latencyBenchmark.cpp \
+	$$PWD/loopbackReceiver.cpp \
+	$$PWD/strategyBenchmark.cpp \
+	$$PWD/codecBenchmark.cpp \
+	$$PWD/conversionBenchmark.cpp \
+	$$GAMEPAD_DIR/strategy.cpp \
+	$$GAMEPAD_DIR/standardStrategy.cpp \
+	$$GAMEPAD_DIR/accelerateStrategy.cpp \
+	$$GAMEPAD_DIR/controlScheduler.cpp \
+	$$GAMEPAD_DIR/strategyController.cpp \
+	$$GAMEPAD_DIR/padDeltaFilter.cpp \
+	$$GAMEPAD_DIR/inputRecorder.cpp \
+	$$GAMEPAD_DIR/connectionPool.cpp \
+	$$GAMEPAD_DIR/connectionManager.cpp \
+	$$GAMEPAD_DIR/commandCodec.cpp \
+	$$GAMEPAD_DIR/sendQueue.cpp \
+	$$GAMEPAD_DIR/linkStatistics.cpp \
+	$$GAMEPAD_DIR/frameConverter.cpp
+
+HEADERS += \
+	$$PWD/controlJitterBenchmark.h \
+	$$PWD/latencyBenchmark.h \
+	$$PWD/loopbackReceiver.h \
+	$$PWD/strategyBenchmark.h \
+	$$PWD/codecBenchmark.h \
+	$$PWD/conversionBenchmark.h \
+	$$GAMEPAD_DIR/strategy.h \
+	$$GAMEPAD_DIR/standardStrategy.h \
+	$$GAMEPAD_DIR/accelerateStrategy.h \
+	$$GAMEPAD_DIR/controlScheduler.h \
+	$$GAMEPAD_DIR/strategyController.h \
+	$$GAMEPAD_DIR/inputQueue.h \
+	$$GAMEPAD_DIR/padDeltaFilter.h \
+	$$GAMEPAD_DIR/inputRecorder.h \
+	$$GAMEPAD_DIR/commandFrame.h \
+	$$GAMEPAD_DIR/gamepadCommand.h \
+	$$GAMEPAD_DIR/controlKeys.h \
+	$$GAMEPAD_DIR/connectionPool.h \
+	$$GAMEPAD_DIR/connectionManager.h \
+	$$GAMEPAD_DIR/commandCodec.h \
+	$$GAMEPAD_DIR/sendQueue.h \
+	$$GAMEPAD_DIR/linkStatistics.h \
+	$$GAMEPAD_DIR/encodedFrame.h \
+	$$GAMEPAD_DIR/frameConverter.h \
+	$$GAMEPAD_DIR/poolTask.h
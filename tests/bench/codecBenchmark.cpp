@@ -0,0 +1,122 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "codecBenchmark.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTextStream>
+#include <QtCore/QVector>
+
+#include "commandCodec.h"
+
+namespace {
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+/// Pseudo-random pads, pad releases, buttons and keepalives in proportions of a drive, the same for every run
+QVector<GamepadCommand> randomCommands(int count)
+{
+	QVector<GamepadCommand> result;
+	result.reserve(count);
+	quint32 random = 12345;
+	for (int i = 0; i < count; ++i) {
+		random = random * 1103515245u + 12345u;
+		const int choice = static_cast<int>((random >> 16) % 100);
+		const int x = static_cast<int>((random >> 4) % 201) - 100;
+		const int y = static_cast<int>((random >> 12) % 201) - 100;
+		GamepadCommand command;
+		if (choice < 80) {
+			command = GamepadCommand::pad(1 + choice % 2, x, y);
+		} else if (choice < 90) {
+			command = GamepadCommand::padUp(1 + choice % 2);
+		} else if (choice < 97) {
+			command = GamepadCommand::button(1 + choice % 5);
+		} else {
+			command = GamepadCommand::keepalive(1000 + choice);
+		}
+
+		command.sequence = static_cast<quint16>(i);
+		result.append(command);
+	}
+
+	return result;
+}
+
+/// Returns true if decoded command carries the same data, sequence is transferred by binary protocol only
+bool same(const GamepadCommand &decoded, const GamepadCommand &original, bool withSequence)
+{
+	return decoded.type == original.type && decoded.id == original.id && decoded.x == original.x
+			&& decoded.y == original.y && decoded.value == original.value
+			&& (!withSequence || decoded.sequence == original.sequence);
+}
+
+/// Encodes and decodes all commands with given protocol, returns true if every one of them survives
+bool measure(const char *name, CommandCodec::Protocol protocol, const QVector<GamepadCommand> &sequence)
+{
+	const CommandCodec codec(protocol);
+	QByteArray buffer;
+	const auto encodeAll = [&codec, &buffer, &sequence]() {
+		buffer.resize(0);
+		for (const auto &command : sequence) {
+			codec.encode(command, buffer);
+		}
+	};
+
+	// Warm up caches and grow the buffer to its final size before measuring
+	encodeAll();
+	QElapsedTimer timer;
+	timer.start();
+	encodeAll();
+	const double encodeCost = static_cast<double>(timer.nsecsElapsed()) / sequence.size();
+
+	bool ok = true;
+	int index = 0;
+	int offset = 0;
+	GamepadCommand decoded;
+	timer.start();
+	while (offset < buffer.size()) {
+		const int consumed = CommandCodec::decode(buffer.constData() + offset, buffer.size() - offset, decoded);
+		if (consumed == 0 || index >= sequence.size()
+				|| !same(decoded, sequence[index], protocol == CommandCodec::Protocol::binary)) {
+			ok = false;
+			break;
+		}
+
+		offset += consumed;
+		++index;
+	}
+
+	const double decodeCost = static_cast<double>(timer.nsecsElapsed()) / sequence.size();
+	ok = ok && index == sequence.size();
+
+	out() << name << ": " << (ok ? "every command decoded as encoded" : "ROUND TRIP FAILED") << "\n";
+	out() << "  encode: " << encodeCost << " ns, decode: " << decodeCost << " ns per command, "
+			<< static_cast<double>(buffer.size()) / sequence.size() << " bytes per command" << "\n";
+	out().flush();
+	return ok;
+}
+
+}
+
+int CodecBenchmark::run(int commands)
+{
+	const auto &sequence = randomCommands(qMax(commands, 1));
+	bool ok = measure("Text protocol", CommandCodec::Protocol::text, sequence);
+	ok = measure("Binary protocol", CommandCodec::Protocol::binary, sequence) && ok;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,25 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+/// Microbenchmark of CommandCodec. A pseudo-random mix of the commands gamepad sends is encoded and decoded back in
+/// both protocols. Every decoded command is compared with the original, so the benchmark doubles as a round-trip
+/// check, and cost of encoding and decoding a command is printed for each protocol.
+class CodecBenchmark
+{
+public:
+	/// Runs benchmark with given number of commands, returns process exit code: 0 if every command survives
+	static int run(int commands);
+};
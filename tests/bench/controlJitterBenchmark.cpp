@@ -0,0 +1,145 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "controlJitterBenchmark.h"
+
+#include <QtCore/QTextStream>
+
+#include <algorithm>
+
+#include "loopbackReceiver.h"
+
+namespace {
+
+const char *const runNames[] = { "GUI thread", "control thread" };
+constexpr int runCount = sizeof(runNames) / sizeof(runNames[0]);
+
+/// Period of synthetic video frames, in ms
+constexpr int videoFramePeriod = 33;
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+}
+
+ControlJitterBenchmark::ControlJitterBenchmark(int rate, int ticks, QObject *parent)
+	: QObject(parent)
+	, mRate(qBound(1, rate, ControlScheduler::maxRate))
+	, mTicks(qMax(ticks, 2))
+	, mVideoFrame(1920, 1080, QImage::Format_RGB32)
+{
+	mVideoFrame.fill(Qt::darkGray);
+	connect(&mLoadTimer, &QTimer::timeout, this, &ControlJitterBenchmark::renderFrame);
+}
+
+ControlJitterBenchmark::~ControlJitterBenchmark()
+{
+	delete mController;
+}
+
+void ControlJitterBenchmark::start()
+{
+	mLoadTimer.start(videoFramePeriod);
+	startRun();
+}
+
+void ControlJitterBenchmark::startRun()
+{
+	// One timestamp more than ticks, the first one starts the first interval
+	mFrameTimes.assign(static_cast<size_t>(mTicks + 1), 0);
+	mFrameCount = 0;
+
+	// Frames are taken straight from the strategy, PadDeltaFilter would hide ticks of a saturated pad
+	auto strategy = new AccelerateStrategy(300);
+	strategy->setControlRate(mRate);
+	connect(strategy, &Strategy::framePrepared, this, &ControlJitterBenchmark::recordFrame, Qt::DirectConnection);
+	QKeyEvent press(QEvent::KeyPress, Qt::Key_W, Qt::NoModifier);
+	if (mRun == 0) {
+		mStrategy = strategy;
+		mStrategy->setParent(this);
+		mStrategy->processEvent(&press);
+	} else {
+		mController = new StrategyController(this);
+		mController->setStrategy(strategy);
+		mController->post(press);
+	}
+}
+
+void ControlJitterBenchmark::recordFrame()
+{
+	const int index = mFrameCount.load(std::memory_order_relaxed);
+	if (index >= static_cast<int>(mFrameTimes.size())) {
+		return;
+	}
+
+	mFrameTimes[static_cast<size_t>(index)] = LoopbackReceiver::now();
+	mFrameCount.store(index + 1, std::memory_order_release);
+	if (index + 1 == static_cast<int>(mFrameTimes.size())) {
+		QMetaObject::invokeMethod(this, [this]() { finishRun(); }, Qt::QueuedConnection);
+	}
+}
+
+void ControlJitterBenchmark::finishRun()
+{
+	// The strategy is stopped before its results are read, deleting controller joins control thread
+	delete mStrategy;
+	mStrategy = nullptr;
+	delete mController;
+	mController = nullptr;
+
+	printReport();
+	if (++mRun < runCount) {
+		startRun();
+	} else {
+		mLoadTimer.stop();
+		Q_EMIT finished(0);
+	}
+}
+
+void ControlJitterBenchmark::renderFrame()
+{
+	const auto begin = LoopbackReceiver::now();
+	const auto scaled = mVideoFrame.scaled(1280, 720, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	const auto converted = scaled.convertToFormat(QImage::Format_RGB888);
+	Q_UNUSED(converted)
+	mRenderTime += LoopbackReceiver::now() - begin;
+	++mRenderedFrames;
+}
+
+void ControlJitterBenchmark::printReport()
+{
+	const qint64 period = 1000 / mRate * 1000;
+	std::vector<qint64> deviations;
+	deviations.reserve(mFrameTimes.size());
+	for (size_t i = 1; i < mFrameTimes.size(); ++i) {
+		deviations.push_back(qAbs(mFrameTimes[i] - mFrameTimes[i - 1] - period));
+	}
+
+	std::sort(deviations.begin(), deviations.end());
+	const auto percentile = [&deviations](size_t percent) {
+		return deviations[(deviations.size() - 1) * percent / 100];
+	};
+
+	out() << "Strategy in " << runNames[mRun] << ": " << deviations.size() << " ticks at " << mRate
+			<< " Hz, deviation from " << period << " us period p50=" << percentile(50) << " p95="
+			<< percentile(95) << " p99=" << percentile(99) << " max=" << deviations.back() << " us\n";
+	out() << "  video load: " << mRenderedFrames << " frames, "
+			<< (mRenderedFrames ? mRenderTime / mRenderedFrames : 0) << " us per frame\n";
+	out().flush();
+	mRenderedFrames = 0;
+	mRenderTime = 0;
+}
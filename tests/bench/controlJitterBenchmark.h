@@ -0,0 +1,73 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtGui/QImage>
+
+#include <atomic>
+#include <vector>
+
+#include "accelerateStrategy.h"
+#include "strategyController.h"
+
+/// Measures jitter of control ticks while this thread is busy with synthetic video load: 30 times a second a full HD
+/// picture is scaled and converted, as video widget does with camera frames. AccelerateStrategy with a key held
+/// emits a frame on every tick, so intervals between frames show the jitter. The strategy runs first in the loaded
+/// thread, as gamepad did before StrategyController, then in control thread.
+class ControlJitterBenchmark : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(ControlJitterBenchmark)
+
+public:
+	/// Creates benchmark of given control rate measuring given number of ticks in each run
+	ControlJitterBenchmark(int rate, int ticks, QObject *parent = nullptr);
+	~ControlJitterBenchmark() override;
+
+	/// Starts the load and the first run
+	void start();
+
+signals:
+	/// Emitted when both runs are measured, with process exit code
+	void finished(int exitCode);
+
+private:
+	void startRun();
+	void finishRun();
+	void renderFrame();
+
+	/// Takes the time of a frame, called in the thread running the strategy
+	void recordFrame();
+
+	void printReport();
+
+	const int mRate;
+	const int mTicks;
+
+	QTimer mLoadTimer;
+	QImage mVideoFrame;
+	int mRenderedFrames {};
+	qint64 mRenderTime {};
+
+	int mRun {};
+	AccelerateStrategy *mStrategy {}; // Has ownership (QObject child), runs in this thread
+	StrategyController *mController {}; // Has ownership (QObject child)
+
+	/// Times of strategy frames in microseconds, written by the thread running the strategy until it is full
+	std::vector<qint64> mFrameTimes;
+	std::atomic<int> mFrameCount { 0 };
+};
@@ -0,0 +1,217 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "conversionBenchmark.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+
+#include <cstdlib>
+
+#include "frameConverter.h"
+
+namespace {
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+constexpr int frameWidth = 1920;
+constexpr int frameHeight = 1080;
+
+/// Rows are padded like decoders do, so kernels that ignore strides fail the check
+constexpr int padding = 64;
+
+/// Screenshot conversion as it was before FrameConverter, the baseline for comparison. Expects tightly packed I420.
+QImage referenceConvert(const uchar *data, int width, int height)
+{
+	const int size = height * width;
+	QImage img(width, height, QImage::Format_RGB32);
+	for (int i = 0; i < height; i++)
+		for (int j = 0; j < width; j++) {
+			int y = static_cast<int> (data[i * width + j]);
+			int u = static_cast<int> (data[(i / 2) * (width / 2) + (j / 2) + size]);
+			int v = static_cast<int> (data[(i / 2) * (width / 2) + (j / 2) + size + (size / 4)]);
+
+			int r = y + int(1.13983 * (v - 128));
+			int g = y - int(0.39465 * (u - 128)) - int(0.58060 * (v - 128));
+			int b = y + int(2.03211 * (u - 128));
+
+			r = qBound(0, r, 255);
+			g = qBound(0, g, 255);
+			b = qBound(0, b, 255);
+
+			img.setPixel(j, i, qRgb(r, g, b));
+		}
+
+	return img;
+}
+
+/// Plane filled with a smooth gradient with some noise, the same for every run
+QByteArray plane(int rowBytes, int rows, int stride, quint32 seed)
+{
+	QByteArray result(stride * rows, '\0');
+	quint32 random = seed;
+	for (int i = 0; i < rows; ++i) {
+		for (int j = 0; j < rowBytes; ++j) {
+			random = random * 1103515245u + 12345u;
+			result[i * stride + j] = static_cast<char>((i + j) / 4 + static_cast<int>((random >> 16) % 32));
+		}
+	}
+
+	return result;
+}
+
+/// Largest difference of a color channel between two images
+int maxDifference(const QImage &left, const QImage &right)
+{
+	int result = 0;
+	for (int i = 0; i < left.height(); ++i) {
+		const auto leftRow = reinterpret_cast<const QRgb *>(left.constScanLine(i));
+		const auto rightRow = reinterpret_cast<const QRgb *>(right.constScanLine(i));
+		for (int j = 0; j < left.width(); ++j) {
+			result = qMax(result, std::abs(qRed(leftRow[j]) - qRed(rightRow[j])));
+			result = qMax(result, std::abs(qGreen(leftRow[j]) - qGreen(rightRow[j])));
+			result = qMax(result, std::abs(qBlue(leftRow[j]) - qBlue(rightRow[j])));
+		}
+	}
+
+	return result;
+}
+
+/// Average time of converting the picture, in ms
+double frameTime(const YuvImage &image, FrameConverter::Kernel kernel, QImage &result, int frames)
+{
+	result = QImage(image.width, image.height, QImage::Format_RGB32);
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < frames; ++i) {
+		FrameConverter::convert(image, result.bits(), result.bytesPerLine(), 0, image.height, kernel);
+	}
+
+	return timer.nsecsElapsed() / 1e6 / frames;
+}
+
+/// Converts picture with every supported kernel, returns true if they all produce the same pixels
+bool measure(const char *name, const YuvImage &image, int frames)
+{
+	out() << name << ":\n";
+	bool same = true;
+	QImage scalar;
+	for (const auto kernel : {FrameConverter::Kernel::scalar, FrameConverter::Kernel::sse2
+			, FrameConverter::Kernel::avx2}) {
+		if (!FrameConverter::isSupported(kernel)) {
+			continue;
+		}
+
+		QImage result;
+		const double time = frameTime(image, kernel, result, frames);
+		if (kernel == FrameConverter::Kernel::scalar) {
+			scalar = result;
+		}
+
+		const bool equal = result == scalar;
+		same = same && equal;
+		out() << "  " << FrameConverter::name(kernel) << ": " << time << " ms per frame"
+				<< (equal ? "" : ", PIXELS DIFFER FROM SCALAR") << "\n";
+	}
+
+	out().flush();
+	return same;
+}
+
+}
+
+int ConversionBenchmark::run(int frames)
+{
+	const int count = qMax(frames, 1);
+	const int chromaWidth = frameWidth / 2;
+	const int chromaHeight = frameHeight / 2;
+	bool ok = true;
+
+	const auto &luma = plane(frameWidth, frameHeight, frameWidth + padding, 1);
+	const auto &u = plane(chromaWidth, chromaHeight, chromaWidth + padding, 2);
+	const auto &v = plane(chromaWidth, chromaHeight, chromaWidth + padding, 3);
+	YuvImage i420;
+	i420.width = frameWidth;
+	i420.height = frameHeight;
+	i420.data[0] = reinterpret_cast<const uchar *>(luma.constData());
+	i420.data[1] = reinterpret_cast<const uchar *>(u.constData());
+	i420.data[2] = reinterpret_cast<const uchar *>(v.constData());
+	i420.stride[0] = frameWidth + padding;
+	i420.stride[1] = chromaWidth + padding;
+	i420.stride[2] = chromaWidth + padding;
+	ok = measure("I420", i420, count) && ok;
+
+	// Bands of the picture on all cores, as screenshots are made
+	QImage parallel(frameWidth, frameHeight, QImage::Format_RGB32);
+	QElapsedTimer parallelTimer;
+	parallelTimer.start();
+	for (int i = 0; i < count; ++i) {
+		FrameConverter::convertParallel(i420, parallel.bits(), parallel.bytesPerLine(), *QThreadPool::globalInstance());
+	}
+
+	const double parallelTime = parallelTimer.nsecsElapsed() / 1e6 / count;
+	const bool parallelSame = parallel == FrameConverter::toImage(i420);
+	ok = ok && parallelSame;
+	out() << "  " << FrameConverter::name(FrameConverter::bestKernel()) << " on "
+			<< QThreadPool::globalInstance()->maxThreadCount() << " threads: " << parallelTime << " ms per frame"
+			<< (parallelSame ? "" : ", PIXELS DIFFER FROM SERIAL") << "\n";
+
+	// The old loop ignores strides, so it gets the same picture packed tightly
+	QByteArray packed;
+	for (int index = 0; index < 3; ++index) {
+		const int rows = index == 0 ? frameHeight : chromaHeight;
+		const int rowBytes = index == 0 ? frameWidth : chromaWidth;
+		for (int i = 0; i < rows; ++i) {
+			packed.append(reinterpret_cast<const char *>(i420.data[index]) + i * i420.stride[index], rowBytes);
+		}
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	QImage reference;
+	for (int i = 0; i < count; ++i) {
+		reference = referenceConvert(reinterpret_cast<const uchar *>(packed.constData()), frameWidth, frameHeight);
+	}
+
+	const double referenceTime = timer.nsecsElapsed() / 1e6 / count;
+	const int difference = maxDifference(FrameConverter::toImage(i420), reference);
+
+	// The old loop truncates every term, fixed point rounds their sum, so channels may differ by a couple of levels
+	ok = ok && difference <= 2;
+	out() << "  reference: " << referenceTime << " ms per frame, largest channel difference " << difference << "\n";
+
+	const auto &uv = plane(frameWidth, chromaHeight, frameWidth + padding, 4);
+	YuvImage nv12 = i420;
+	nv12.layout = YuvImage::Layout::nv12;
+	nv12.data[1] = reinterpret_cast<const uchar *>(uv.constData());
+	nv12.stride[1] = frameWidth + padding;
+	ok = measure("NV12", nv12, count) && ok;
+
+	const auto &yuyv = plane(2 * frameWidth, frameHeight, 2 * frameWidth + padding, 5);
+	YuvImage packedImage;
+	packedImage.layout = YuvImage::Layout::yuyv;
+	packedImage.width = frameWidth;
+	packedImage.height = frameHeight;
+	packedImage.data[0] = reinterpret_cast<const uchar *>(yuyv.constData());
+	packedImage.stride[0] = 2 * frameWidth + padding;
+	ok = measure("YUYV", packedImage, count) && ok;
+
+	return ok ? 0 : 1;
+}
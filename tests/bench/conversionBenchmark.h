@@ -0,0 +1,27 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+/// Microbenchmark of FrameConverter. Full HD pictures with padded rows are converted by every kernel the CPU
+/// supports, I420 also in parallel bands and by a copy of the per-pixel loop the screenshot code used before.
+/// Kernels are checked to produce the same pixels as the scalar one and to stay close to the old loop, time per frame
+/// is printed for each.
+class ConversionBenchmark
+{
+public:
+	/// Runs benchmark converting given number of frames with each kernel, returns process exit code: 0 if results
+	/// agree
+	static int run(int frames);
+};
@@ -0,0 +1,228 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "latencyBenchmark.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QTextStream>
+#include <QtGui/QKeyEvent>
+
+#include <algorithm>
+
+namespace {
+
+/// Keys pressed and released in turn. Pad keys are used, so every event of StandardStrategy produces a frame.
+const int benchmarkKeys[] = { Qt::Key_W, Qt::Key_Up };
+constexpr int benchmarkKeyCount = sizeof(benchmarkKeys) / sizeof(benchmarkKeys[0]);
+
+const struct {
+	Strategies type;
+	const char *name;
+} benchmarkStrategies[] = {
+	{ Strategies::standartStrategy, "StandardStrategy" }
+	, { Strategies::accelerateStrategy, "AccelerateStrategy" }
+};
+
+constexpr int benchmarkStrategyCount = sizeof(benchmarkStrategies) / sizeof(benchmarkStrategies[0]);
+
+/// Time to let the last frames reach the receiver, in ms
+constexpr int drainTime = 1000;
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+/// Prints distribution of durations in microseconds
+void printStage(const char *name, QVector<qint64> &durations)
+{
+	out() << "  " << QString(name).leftJustified(16);
+	if (durations.isEmpty()) {
+		out() << "no samples\n";
+		return;
+	}
+
+	std::sort(durations.begin(), durations.end());
+	const auto percentile = [&durations](int percent) {
+		return durations[(durations.size() - 1) * percent / 100];
+	};
+
+	out() << "n=" << durations.size() << " p50=" << percentile(50) << " p95=" << percentile(95)
+			<< " p99=" << percentile(99) << " max=" << durations.last() << " us\n";
+}
+
+}
+
+LatencyBenchmark::LatencyBenchmark(int rate, int count, QObject *parent)
+	: QObject(parent)
+	, mRate(qMax(rate, 1))
+	, mCount((qMax(count, 2) + 1) / 2 * 2)
+	, mSettings(QSettings::Format::NativeFormat, QSettings::Scope::UserScope, "CyberTech Labs"
+			, "desktop-gamepad-benchmark")
+{
+	mInjectTimer.setTimerType(Qt::PreciseTimer);
+	connect(&mInjectTimer, &QTimer::timeout, this, &LatencyBenchmark::injectKey);
+}
+
+LatencyBenchmark::~LatencyBenchmark()
+{
+	delete mPool;
+	mReceiverThread.quit();
+	mReceiverThread.wait();
+}
+
+void LatencyBenchmark::start()
+{
+	mReceiver = new LoopbackReceiver();
+	mReceiver->moveToThread(&mReceiverThread);
+	connect(&mReceiverThread, &QThread::finished, mReceiver, &QObject::deleteLater);
+	connect(mReceiver, &LoopbackReceiver::listening, this, &LatencyBenchmark::onListening);
+	connect(mReceiver, &LoopbackReceiver::commandReceived, this, [this](quint16 sequence, qint64 time) {
+		const auto sample = mSamples.find(sequence);
+		if (sample != mSamples.end()) {
+			sample->receivedAt = time;
+		}
+	});
+	mReceiverThread.start();
+	QMetaObject::invokeMethod(mReceiver, "listen", Qt::QueuedConnection);
+}
+
+void LatencyBenchmark::onListening(quint16 port)
+{
+	if (port == 0) {
+		qCritical() << "Loopback receiver can not listen";
+		Q_EMIT finished(1);
+		return;
+	}
+
+	// Binary protocol carries sequence numbers, they match frames written by gamepad with received ones
+	mSettings.setValue("gamepadIp", "127.0.0.1");
+	mSettings.setValue("gamepadPort", static_cast<uint>(port));
+	mSettings.setValue("padTransport", "tcp");
+	mSettings.setValue("binaryProtocol", true);
+
+	mPool = new ConnectionPool(&mSettings, this);
+	auto manager = mPool->manager(0);
+	connect(manager, &ConnectionManager::protocolChanged, this, [this](bool binary) {
+		if (binary && !mStarted) {
+			mStarted = true;
+			startStrategy();
+		}
+	});
+	connect(manager, &ConnectionManager::connectionFailed, this, [this]() {
+		qCritical() << "Can not connect to loopback receiver";
+		Q_EMIT finished(1);
+	});
+
+	// Direct connections take the time in the thread where the stage ends, results are recorded in this thread
+	connect(manager, &ConnectionManager::frameWritten, this, [this](quint16 sequence) {
+		const auto time = LoopbackReceiver::now();
+		QMetaObject::invokeMethod(this, [this, sequence, time]() {
+			const auto sample = mSamples.find(sequence);
+			if (sample != mSamples.end()) {
+				sample->writtenAt = time;
+			}
+		}, Qt::QueuedConnection);
+	}, Qt::DirectConnection);
+	connect(mPool, &ConnectionPool::encodedFrameReady, this, [this](const EncodedFrame &frame) {
+		auto &sample = mSamples[frame.frame.at(0).sequence];
+		sample.keyAt = mPendingKeyAt;
+		sample.preparedAt = mPreparedAt;
+		mPendingKeyAt = -1;
+	}, Qt::DirectConnection);
+
+	QMetaObject::invokeMethod(manager, "reconnectToHost", Qt::QueuedConnection);
+}
+
+void LatencyBenchmark::startStrategy()
+{
+	mSamples.clear();
+	mInjected = 0;
+	mPendingKeyAt = -1;
+	mStrategy = Strategy::getStrategy(benchmarkStrategies[mStrategyIndex].type, this);
+	connect(mStrategy, &Strategy::framePrepared, this, &LatencyBenchmark::onFrame);
+	mInjectTimer.start(1000 / mRate);
+}
+
+void LatencyBenchmark::injectKey()
+{
+	// Every key is pressed by one event and released by the next one
+	const int key = benchmarkKeys[(mInjected / 2) % benchmarkKeyCount];
+	const auto type = mInjected % 2 == 0 ? QEvent::KeyPress : QEvent::KeyRelease;
+	QKeyEvent keyEvent(type, key, Qt::NoModifier);
+	if (mPendingKeyAt < 0) {
+		mPendingKeyAt = LoopbackReceiver::now();
+	}
+
+	mStrategy->processEvent(&keyEvent);
+
+	if (++mInjected == mCount) {
+		mInjectTimer.stop();
+		QTimer::singleShot(drainTime, this, &LatencyBenchmark::finishStrategy);
+	}
+}
+
+void LatencyBenchmark::onFrame(const CommandFrame &frame)
+{
+	mPreparedAt = LoopbackReceiver::now();
+	mPool->dispatch(frame);
+}
+
+void LatencyBenchmark::finishStrategy()
+{
+	printReport();
+	mStrategy->deleteLater();
+	mStrategy = nullptr;
+
+	if (++mStrategyIndex < benchmarkStrategyCount) {
+		startStrategy();
+	} else {
+		Q_EMIT finished(0);
+	}
+}
+
+void LatencyBenchmark::printReport() const
+{
+	QVector<qint64> strategy;
+	QVector<qint64> handOff;
+	QVector<qint64> wire;
+	QVector<qint64> total;
+	int lost = 0;
+	for (const auto &sample : mSamples) {
+		// Frames produced by timers of a strategy without a new key event have no key stage
+		if (sample.keyAt >= 0) {
+			strategy.append(sample.preparedAt - sample.keyAt);
+		}
+
+		if (sample.writtenAt < 0 || sample.receivedAt < 0) {
+			++lost;
+			continue;
+		}
+
+		handOff.append(sample.writtenAt - sample.preparedAt);
+		wire.append(sample.receivedAt - sample.writtenAt);
+		if (sample.keyAt >= 0) {
+			total.append(sample.receivedAt - sample.keyAt);
+		}
+	}
+
+	out() << benchmarkStrategies[mStrategyIndex].name << ": " << mCount << " key events at " << mRate
+			<< "/s, " << mSamples.size() << " frames, " << lost << " not delivered\n";
+	printStage("key -> frame", strategy);
+	printStage("frame -> socket", handOff);
+	printStage("socket -> robot", wire);
+	printStage("total", total);
+	out().flush();
+}
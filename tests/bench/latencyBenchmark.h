@@ -0,0 +1,91 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QSettings>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include "connectionPool.h"
+#include "loopbackReceiver.h"
+#include "strategy.h"
+
+/// Measures how long it takes a key press to reach the robot. Synthetic key events are injected at given rate
+/// into every strategy, frames go through ConnectionPool and ConnectionManager to LoopbackReceiver on 127.0.0.1.
+/// Latency is reported per stage:
+/// * key -> frame --- Strategy::processEvent until framePrepared, includes timer ticks of AccelerateStrategy;
+/// * frame -> socket --- dispatch, queued delivery to network thread and encoding, until data is written to socket;
+/// * socket -> robot --- from socket write until the receiver reads the command;
+/// * total --- key event until the receiver reads the command.
+class LatencyBenchmark : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(LatencyBenchmark)
+
+public:
+	/// Creates benchmark injecting rate events per second, count (rounded up to even) events for every strategy
+	LatencyBenchmark(int rate, int count, QObject *parent = nullptr);
+	~LatencyBenchmark() override;
+
+	/// Starts receiver and connects to it, measurement starts when binary protocol is negotiated
+	void start();
+
+signals:
+	/// Emitted when all strategies are measured or the receiver is unreachable, with process exit code
+	void finished(int exitCode);
+
+private slots:
+	void onListening(quint16 port);
+	void injectKey();
+	void onFrame(const CommandFrame &frame);
+
+private:
+	/// Timestamps of one frame, in microseconds, -1 if the stage was not reached
+	struct Sample {
+		qint64 keyAt { -1 };
+		qint64 preparedAt { -1 };
+		qint64 writtenAt { -1 };
+		qint64 receivedAt { -1 };
+	};
+
+	void startStrategy();
+	void finishStrategy();
+	void printReport() const;
+
+	const int mRate;
+	const int mCount;
+
+	/// Settings of benchmark connection, kept apart from the gamepad ones
+	QSettings mSettings;
+
+	QThread mReceiverThread;
+	LoopbackReceiver *mReceiver {}; // Ownership is passed to the thread
+	ConnectionPool *mPool {}; // Has ownership (QObject child)
+	Strategy *mStrategy {}; // Has ownership (QObject child)
+
+	QTimer mInjectTimer;
+	int mStrategyIndex {};
+	int mInjected {};
+	bool mStarted {};
+
+	/// Time of the oldest key event which has not produced a frame yet, -1 if there is no such event
+	qint64 mPendingKeyAt { -1 };
+	qint64 mPreparedAt { -1 };
+
+	/// Samples of current strategy by sequence number of the first command of the frame
+	QHash<quint16, Sample> mSamples;
+};
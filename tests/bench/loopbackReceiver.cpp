@@ -0,0 +1,85 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "loopbackReceiver.h"
+
+#include <chrono>
+
+LoopbackReceiver::LoopbackReceiver(QObject *parent)
+	: QObject(parent)
+{
+}
+
+qint64 LoopbackReceiver::now()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void LoopbackReceiver::listen()
+{
+	// Created here, so the server and its sockets belong to the receiver thread
+	mServer = new QTcpServer(this);
+	connect(mServer, &QTcpServer::newConnection, this, &LoopbackReceiver::onNewConnection);
+	mServer->listen(QHostAddress::LocalHost);
+	Q_EMIT listening(mServer->serverPort());
+}
+
+void LoopbackReceiver::onNewConnection()
+{
+	while (auto socket = mServer->nextPendingConnection()) {
+		// Only the latest gamepad connection is measured
+		if (mSocket) {
+			mSocket->deleteLater();
+		}
+
+		mSocket = socket;
+		mSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+		mInBuffer.clear();
+		mCodec.setProtocol(CommandCodec::Protocol::text);
+		connect(mSocket, &QTcpSocket::readyRead, this, &LoopbackReceiver::onReadyRead);
+	}
+}
+
+void LoopbackReceiver::onReadyRead()
+{
+	const auto time = now();
+	mInBuffer.append(mSocket->readAll());
+	int position = 0;
+	GamepadCommand command;
+	mOutBuffer.resize(0);
+	while (const int consumed = CommandCodec::decode(mInBuffer.constData() + position
+			, mInBuffer.size() - position, command)) {
+		position += consumed;
+		switch (command.type) {
+		case GamepadCommand::Type::protocol:
+			mCodec.encode(command, mOutBuffer);
+			mCodec.setProtocol(CommandCodec::Protocol::binary);
+			break;
+		case GamepadCommand::Type::ping:
+			mCodec.encode(GamepadCommand::echo(command.value), mOutBuffer);
+			break;
+		case GamepadCommand::Type::invalid:
+			break;
+		default:
+			Q_EMIT commandReceived(command.sequence, time);
+			break;
+		}
+	}
+
+	mInBuffer.remove(0, position);
+	if (!mOutBuffer.isEmpty()) {
+		mSocket->write(mOutBuffer);
+	}
+}
@@ -0,0 +1,58 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include "commandCodec.h"
+
+/// Minimal robot on the loopback interface for latency benchmark. Accepts binary protocol, answers pings and
+/// reports arrival time of every command. Meant to live in its own thread, so it reads data as soon as it arrives.
+class LoopbackReceiver : public QObject
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(LoopbackReceiver)
+
+public:
+	explicit LoopbackReceiver(QObject *parent = nullptr);
+
+	/// Current time of the clock shared by benchmark stages, in microseconds
+	static qint64 now();
+
+public slots:
+	/// Starts listening on a free port of 127.0.0.1, the port is reported by listening signal
+	void listen();
+
+signals:
+	/// Emitted when the receiver is ready to accept connection on given port
+	void listening(quint16 port);
+
+	/// Emitted for every command with time of its arrival
+	void commandReceived(quint16 sequence, qint64 time);
+
+private slots:
+	void onNewConnection();
+	void onReadyRead();
+
+private:
+	QTcpServer *mServer {}; // Has ownership (QObject child)
+	QTcpSocket *mSocket {}; // Has ownership (QObject child of server)
+
+	CommandCodec mCodec;
+	QByteArray mInBuffer;
+	QByteArray mOutBuffer;
+};
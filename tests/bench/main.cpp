@@ -0,0 +1,77 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/* Benchmarks of the gamepad, kept apart from the shipped binary. One benchmark is run per call, the exit code is 0
+ * if it passed its checks, 1 if not and 2 if the command line is wrong. */
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+#include "codecBenchmark.h"
+#include "controlJitterBenchmark.h"
+#include "conversionBenchmark.h"
+#include "latencyBenchmark.h"
+#include "strategyBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Benchmarks and equivalence checks of TRIK desktop gamepad.");
+	parser.addHelpOption();
+	parser.addOption({"latency", "Measure key-to-wire latency against loopback receiver."});
+	parser.addOption({"strategies", "Compare strategies with their reference implementations and time them."});
+	parser.addOption({"codec", "Check that commands survive encoding and decoding and time both."});
+	parser.addOption({"convert", "Compare screenshot conversion kernels with the old loop and time them."});
+	parser.addOption({"control", "Measure jitter of control ticks under synthetic video load."});
+	parser.addOption({"rate", "Key events (or control ticks) per second.", "count", "50"});
+	parser.addOption({"count", "Key events, control ticks, commands or frames to measure.", "count"});
+	parser.process(application);
+
+	const auto count = [&parser](int defaultCount) {
+		return parser.isSet("count") ? parser.value("count").toInt() : defaultCount;
+	};
+
+	if (parser.isSet("latency")) {
+		LatencyBenchmark benchmark(parser.value("rate").toInt(), count(1000));
+		QObject::connect(&benchmark, &LatencyBenchmark::finished, &application, &QCoreApplication::exit
+				, Qt::QueuedConnection);
+		benchmark.start();
+		return application.exec();
+	}
+
+	if (parser.isSet("strategies")) {
+		return StrategyBenchmark::run(count(1000000));
+	}
+
+	if (parser.isSet("codec")) {
+		return CodecBenchmark::run(count(1000000));
+	}
+
+	if (parser.isSet("convert")) {
+		return ConversionBenchmark::run(count(20));
+	}
+
+	if (parser.isSet("control")) {
+		ControlJitterBenchmark benchmark(parser.value("rate").toInt(), count(500));
+		QObject::connect(&benchmark, &ControlJitterBenchmark::finished, &application, &QCoreApplication::exit
+				, Qt::QueuedConnection);
+		benchmark.start();
+		return application.exec();
+	}
+
+	qCritical().noquote() << parser.helpText();
+	return 2;
+}
@@ -0,0 +1,557 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "strategyBenchmark.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+#include <QtCore/QTextStream>
+#include <QtCore/QVector>
+#include <QtGui/QKeyEvent>
+
+#include <algorithm>
+#include <functional>
+
+#include "standardStrategy.h"
+#include "accelerateStrategy.h"
+
+namespace {
+
+QTextStream &out()
+{
+	static QTextStream stream(stdout);
+	return stream;
+}
+
+/// StandardStrategy as it was before it became table-driven, the baseline for comparison
+class ReferenceStandardStrategy : public Strategy
+{
+public:
+	void processEvent(QEvent *event) final
+	{
+		int resultingPowerX1 = 0;
+		int resultingPowerY1 = 0;
+		int resultingPowerX2 = 0;
+		int resultingPowerY2 = 0;
+
+		if (event->type() == QKeyEvent::KeyPress) {
+			auto key = (dynamic_cast<QKeyEvent *> (event))->key();
+			mPressedKeys += key;
+			resultingPowerX1 = (mPressedKeys.contains(Qt::Key_D) ? 100 : 0)
+					+ (mPressedKeys.contains(Qt::Key_A) ? -100 : 0);
+			resultingPowerY1 = (mPressedKeys.contains(Qt::Key_S) ? -100 : 0)
+					+ (mPressedKeys.contains(Qt::Key_W) ? 100 : 0);
+			resultingPowerX2 = (mPressedKeys.contains(Qt::Key_Right) ? 100 : 0)
+					+ (mPressedKeys.contains(Qt::Key_Left) ? -100 : 0);
+			resultingPowerY2 = (mPressedKeys.contains(Qt::Key_Down) ? -100 : 0)
+					+ (mPressedKeys.contains(Qt::Key_Up) ? 100 : 0);
+
+			if (resultingPowerX1 != 0 || resultingPowerY1 != 0) {
+				prepareCommand(GamepadCommand::pad(1, resultingPowerX1, resultingPowerY1));
+			}
+
+			if (resultingPowerX2 != 0 || resultingPowerY2 != 0) {
+				prepareCommand(GamepadCommand::pad(2, resultingPowerX2, resultingPowerY2));
+			}
+
+			QMap<int, int> digits = {
+				{Qt::Key_1, 1}
+				, {Qt::Key_2, 2}
+				, {Qt::Key_3, 3}
+				, {Qt::Key_4, 4}
+				, {Qt::Key_5, 5}
+			};
+
+			for (auto &&key : digits.keys()) {
+				if (mPressedKeys.contains(key)) {
+					prepareCommand(GamepadCommand::button(digits[key]));
+				}
+			}
+
+			flushFrame();
+		} else if (event->type() == QKeyEvent::KeyRelease) {
+			auto key = (dynamic_cast<QKeyEvent *> (event))->key();
+			QSet<int> pad1 = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
+			QSet<int> pad2 = {Qt::Key_Left, Qt::Key_Right, Qt::Key_Up, Qt::Key_Down};
+			mPressedKeys -= key;
+
+			if (pad1.contains(key)) {
+				prepareCommand(GamepadCommand::padUp(1));
+			} else if (pad2.contains(key)) {
+				prepareCommand(GamepadCommand::padUp(2));
+			}
+
+			flushFrame();
+		}
+	}
+
+private:
+	QSet<int> mPressedKeys;
+};
+
+/// AccelerateStrategy as it was before its state became flat arrays. Timers are not connected, the benchmark
+/// simulates them. Pad keys are iterated in the order of ControlKeys ids, the original order of QSet iteration
+/// depended on hash seed of the process.
+class ReferenceAccelerateStrategy : public Strategy
+{
+public:
+	enum Power {
+		X1 = 0
+		, Y1
+		, X2
+		, Y2
+	};
+
+	ReferenceAccelerateStrategy()
+	{
+		pad1 = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
+		pad2 = {Qt::Key_Left, Qt::Key_Right, Qt::Key_Up, Qt::Key_Down};
+		magicButtons = {Qt::Key_1, Qt::Key_2, Qt::Key_3, Qt::Key_4, Qt::Key_5};
+		pad1Order = {Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D};
+		pad2Order = {Qt::Key_Left, Qt::Key_Up, Qt::Key_Right, Qt::Key_Down};
+		powers = {{X1, 0}, {Y1, 0}, {X2, 0}, {Y2, 0}};
+		cntPowers = {{X1, 0}, {Y1, 0}, {X2, 0}, {Y2, 0}};
+		indices = {
+			{Qt::Key_D, X1}, {Qt::Key_A, X1}, {Qt::Key_W, Y1}, {Qt::Key_S, Y1}
+			, {Qt::Key_Right, X2}, {Qt::Key_Left, X2}, {Qt::Key_Up, Y2}, {Qt::Key_Down, Y2}
+		};
+		additions = {
+			{Qt::Key_D, 10}, {Qt::Key_A, -10}, {Qt::Key_W, 10}, {Qt::Key_S, -10}
+			, {Qt::Key_Right, 10}, {Qt::Key_Left, -10}, {Qt::Key_Up, 10}, {Qt::Key_Down, -10}
+		};
+	}
+
+	void processEvent(QEvent *event) final
+	{
+		int eventType = event->type();
+		if (eventType == QEvent::KeyPress || eventType == QEvent::KeyRelease) {
+			auto keyEvent = dynamic_cast<QKeyEvent *> (event);
+			auto key = static_cast<Qt::Key> (keyEvent->key());
+			QSet<int> allKeys = pad1 + pad2 + magicButtons;
+			if (allKeys.contains(key)) {
+				if (!workTimer.isActive())
+					workTimer.start(speed);
+
+				if (magicButtons.contains(key))
+					dealWithButtons(keyEvent);
+				else {
+					if (!keyEvent->isAutoRepeat()) {
+						if (eventType == QEvent::KeyPress)
+							mPressedKeys += key;
+						else
+							mPressedKeys -= key;
+					}
+				}
+			}
+		}
+	}
+
+	void tick()
+	{
+		if (workTimer.isActive()) {
+			dealWithPads();
+		}
+	}
+
+	void expireStopTimer(int pad)
+	{
+		auto &timer = pad == 1 ? stopTimerForPad1 : stopTimerForPad2;
+		if (timer.isActive()) {
+			timer.stop();
+			stopPads(pad);
+		}
+	}
+
+private:
+	void stopPads(int padNumber)
+	{
+		switch (padNumber) {
+		case 1:
+			powers[X1] = powers[Y1] = 0;
+			cntPowers[X1] = 0;
+			pad1WasActive = false;
+			prepareCommand(GamepadCommand::padUp(1));
+			break;
+		case 2:
+			powers[X2] = powers[Y2] = 0;
+			cntPowers[X2] = cntPowers[Y2] = 0;
+			pad2WasActive = false;
+			prepareCommand(GamepadCommand::padUp(2));
+			break;
+		default:
+			break;
+		}
+
+		flushFrame();
+
+		if (!pad1WasActive && !pad2WasActive)
+			workTimer.stop();
+	}
+
+	void dealWithPads()
+	{
+		if (!mPressedKeys.empty()) {
+			bool isSomeKeyFromPad1 = false;
+			for (auto &&pad1Key : qAsConst(pad1Order)) {
+				if (mPressedKeys.contains(pad1Key)) {
+					stopTimerForPad1.start(2 * speed + 100);
+					isSomeKeyFromPad1 = true;
+					pad1WasActive = true;
+					Power index = indices[pad1Key];
+					powers[index] = std::max(-100, std::min(100, powers[index] + additions[pad1Key]));
+					cntPowers[index] = 0;
+				}
+			}
+			if (pad1WasActive) {
+				checkPower(powers[X1], cntPowers[X1], QSet<Qt::Key> {Qt::Key_A, Qt::Key_D});
+				checkPower(powers[Y1], cntPowers[Y1], QSet<Qt::Key> {Qt::Key_W, Qt::Key_S});
+			}
+
+			if (isSomeKeyFromPad1) {
+				prepareCommand(GamepadCommand::pad(1, powers[X1], powers[Y1]));
+			}
+
+			bool isSomeKeyFromPad2 = false;
+			for (auto &&pad2Key : qAsConst(pad2Order)) {
+				if (mPressedKeys.contains(pad2Key)) {
+					stopTimerForPad2.start(2 * speed + 100);
+					isSomeKeyFromPad2 = true;
+					pad2WasActive = true;
+					Power index = indices[pad2Key];
+					powers[index] = std::max(-100, std::min(100, powers[index] + additions[pad2Key]));
+					cntPowers[index] = 0;
+				}
+			}
+			if (pad2WasActive) {
+				checkPower(powers[X2], cntPowers[X2], QSet<Qt::Key> {Qt::Key_Left, Qt::Key_Right});
+				checkPower(powers[Y2], cntPowers[Y2], QSet<Qt::Key> {Qt::Key_Up, Qt::Key_Down});
+			}
+
+			if (isSomeKeyFromPad2) {
+				prepareCommand(GamepadCommand::pad(2, powers[X2], powers[Y2]));
+			}
+
+			flushFrame();
+		}
+	}
+
+	void dealWithButtons(QKeyEvent *keyEvent)
+	{
+		QMap<int, int> digits = {
+			{Qt::Key_1, 1}
+			, {Qt::Key_2, 2}
+			, {Qt::Key_3, 3}
+			, {Qt::Key_4, 4}
+			, {Qt::Key_5, 5}
+		};
+
+		auto key = keyEvent->key();
+		if (keyEvent->type() == QEvent::KeyPress) {
+			prepareCommand(GamepadCommand::button(digits[key]));
+			flushFrame();
+		}
+	}
+
+	void checkPower(int &power, int &cnt, QSet<Qt::Key> set)
+	{
+		if (power) {
+			bool contains = false;
+			for (auto key : set) {
+				contains = contains || mPressedKeys.contains(key);
+			}
+			if (!contains) {
+				if (cnt) {
+					cnt = 0;
+					power = 0;
+				} else {
+					cnt++;
+				}
+			}
+		}
+	}
+
+	QMap<Power, int> powers;
+	QMap<int, Power> indices;
+	QMap<int, int> additions;
+	QMap<Power, int> cntPowers;
+	QTimer stopTimerForPad1;
+	QTimer stopTimerForPad2;
+	bool pad1WasActive { false };
+	bool pad2WasActive { false };
+	QSet<int> pad1;
+	QSet<int> pad2;
+	QVector<int> pad1Order;
+	QVector<int> pad2Order;
+	QSet<int> magicButtons;
+	QTimer workTimer;
+	int speed { 300 };
+	QSet<int> mPressedKeys;
+};
+
+/// AccelerateStrategy with timers fired by the benchmark through its protected interface
+class ManualAccelerateStrategy : public AccelerateStrategy
+{
+public:
+	ManualAccelerateStrategy()
+		: AccelerateStrategy(legacySpeed)
+	{
+	}
+
+	/// Runs a tick one legacy period long if control ticks are running, as the scheduler would do. Ticks come
+	/// exactly every legacy period, so with linear curve and default ramp time power grows by the same steps as
+	/// in the reference
+	void tick()
+	{
+		if (isTicking()) {
+			dealWithPads(legacySpeed * 1000LL);
+		}
+	}
+
+	/// Expires stop timer of given pad if it is running, as the timer would do
+	void expireStopTimer(int pad)
+	{
+		if (isStopTimerActive(pad)) {
+			cancelStopTimer(pad);
+			stopPads(pad);
+		}
+	}
+
+private:
+	/// Speed the strategy is created with in the gamepad, which was also the period of its ticks
+	static constexpr int legacySpeed = 300;
+};
+
+/// Step of the benchmark sequence: key event or expiry of a strategy timer
+struct Step {
+	enum class Kind {
+		key
+		, tick
+		, expirePad1
+		, expirePad2
+	};
+
+	Kind kind;
+	QEvent::Type type;
+	int key;
+};
+
+/// Strategy under benchmark together with a way to fire its timers
+struct Subject {
+	Strategy &strategy;
+	std::function<void()> tick;
+	std::function<void(int)> expireStopTimer;
+};
+
+/// Pseudo-random presses and releases of control keys and a key gamepad ignores, the same for every run.
+/// With timers, ticks and stop timer expiries are mixed in.
+QVector<Step> steps(int count, bool withTimers)
+{
+	const int keys[] = {
+		Qt::Key_W, Qt::Key_A, Qt::Key_S, Qt::Key_D, Qt::Key_Left, Qt::Key_Up, Qt::Key_Right, Qt::Key_Down
+		, Qt::Key_1, Qt::Key_2, Qt::Key_3, Qt::Key_4, Qt::Key_5, Qt::Key_Q
+	};
+	constexpr int keyCount = sizeof(keys) / sizeof(keys[0]);
+
+	QVector<Step> result;
+	result.reserve(count);
+	bool pressed[keyCount] = {};
+	quint32 random = 12345;
+	for (int i = 0; i < count; ++i) {
+		random = random * 1103515245u + 12345u;
+		const int choice = static_cast<int>((random >> 16) % 100);
+		if (withTimers && choice < 30) {
+			result.append({Step::Kind::tick, QEvent::None, 0});
+		} else if (withTimers && choice < 35) {
+			result.append({Step::Kind::expirePad1, QEvent::None, 0});
+		} else if (withTimers && choice < 40) {
+			result.append({Step::Kind::expirePad2, QEvent::None, 0});
+		} else {
+			const int index = static_cast<int>((random >> 8) % keyCount);
+			result.append({Step::Kind::key, pressed[index] ? QEvent::KeyRelease : QEvent::KeyPress, keys[index]});
+			pressed[index] = !pressed[index];
+		}
+	}
+
+	return result;
+}
+
+void apply(Subject &subject, const Step &step)
+{
+	switch (step.kind) {
+	case Step::Kind::key: {
+		QKeyEvent event(step.type, step.key, Qt::NoModifier);
+		subject.strategy.processEvent(&event);
+		break;
+	}
+	case Step::Kind::tick:
+		subject.tick();
+		break;
+	case Step::Kind::expirePad1:
+		subject.expireStopTimer(1);
+		break;
+	case Step::Kind::expirePad2:
+		subject.expireStopTimer(2);
+		break;
+	}
+}
+
+/// Returns true if frames carry the same commands
+bool sameFrames(const QVector<CommandFrame> &left, const QVector<CommandFrame> &right)
+{
+	if (left.size() != right.size()) {
+		return false;
+	}
+
+	for (int i = 0; i < left.size(); ++i) {
+		if (left[i].size() != right[i].size()) {
+			return false;
+		}
+
+		for (int j = 0; j < left[i].size(); ++j) {
+			const auto &command = left[i].at(j);
+			const auto &expected = right[i].at(j);
+			if (command.type != expected.type || command.id != expected.id || command.x != expected.x
+					|| command.y != expected.y || command.value != expected.value) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/// Feeds the sequence to both strategies, returns true if every step makes them produce the same frames
+bool sameBehaviour(Subject &subject, Subject &reference, const QVector<Step> &sequence)
+{
+	QVector<CommandFrame> frames;
+	QVector<CommandFrame> expectedFrames;
+	const auto collect = QObject::connect(&subject.strategy, &Strategy::framePrepared
+			, [&frames](const CommandFrame &frame) { frames.append(frame); });
+	const auto collectExpected = QObject::connect(&reference.strategy, &Strategy::framePrepared
+			, [&expectedFrames](const CommandFrame &frame) { expectedFrames.append(frame); });
+
+	bool same = true;
+	for (const auto &step : sequence) {
+		apply(subject, step);
+		apply(reference, step);
+		if (!sameFrames(frames, expectedFrames)) {
+			same = false;
+			break;
+		}
+
+		frames.clear();
+		expectedFrames.clear();
+	}
+
+	QObject::disconnect(collect);
+	QObject::disconnect(collectExpected);
+	return same;
+}
+
+/// Average cost of a step in nanoseconds
+double stepCost(Subject &subject, const QVector<Step> &sequence)
+{
+	QElapsedTimer timer;
+	timer.start();
+	for (const auto &step : sequence) {
+		apply(subject, step);
+	}
+
+	return static_cast<double>(timer.nsecsElapsed()) / sequence.size();
+}
+
+/// Average cost of a tick with keys of both pads held, in nanoseconds
+double tickCost(Subject &subject, int ticks)
+{
+	for (const int key : {Qt::Key_W, Qt::Key_Up}) {
+		QKeyEvent event(QEvent::KeyPress, key, Qt::NoModifier);
+		subject.strategy.processEvent(&event);
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < ticks; ++i) {
+		subject.tick();
+	}
+
+	const double cost = static_cast<double>(timer.nsecsElapsed()) / ticks;
+	for (const int key : {Qt::Key_W, Qt::Key_Up}) {
+		QKeyEvent event(QEvent::KeyRelease, key, Qt::NoModifier);
+		subject.strategy.processEvent(&event);
+	}
+
+	return cost;
+}
+
+void printCost(const char *what, double cost, double referenceCost)
+{
+	out() << "  " << what << ": " << cost << " ns, reference " << referenceCost << " ns, speedup "
+			<< referenceCost / cost << "x\n";
+}
+
+/// Compares strategy with its reference, returns true if they produce the same frames
+bool compare(const char *name, Subject &subject, Subject &reference, const QVector<Step> &sequence, int ticks)
+{
+	const bool equal = sameBehaviour(subject, reference, sequence);
+	out() << name << ": " << (equal ? "same frames as reference" : "FRAMES DIFFER FROM REFERENCE") << "\n";
+
+	// Warm up caches and allocator before measuring
+	stepCost(subject, sequence);
+	stepCost(reference, sequence);
+	const double cost = stepCost(subject, sequence);
+	const double referenceCost = stepCost(reference, sequence);
+	printCost("step", cost, referenceCost);
+
+	if (ticks > 0) {
+		const double tick = tickCost(subject, ticks);
+		const double referenceTick = tickCost(reference, ticks);
+		printCost("tick", tick, referenceTick);
+	}
+
+	out().flush();
+	return equal;
+}
+
+}
+
+int StrategyBenchmark::run(int events)
+{
+	const int count = qMax(events, 1);
+	bool ok = true;
+
+	StandardStrategy standard;
+	ReferenceStandardStrategy referenceStandard;
+	Subject standardSubject { standard, [](){}, [](int){} };
+	Subject referenceStandardSubject { referenceStandard, [](){}, [](int){} };
+	ok = compare("StandardStrategy", standardSubject, referenceStandardSubject, steps(count, false), 0) && ok;
+
+	ManualAccelerateStrategy accelerate;
+	ReferenceAccelerateStrategy referenceAccelerate;
+	Subject accelerateSubject {
+		accelerate
+		, [&accelerate]() { accelerate.tick(); }
+		, [&accelerate](int pad) { accelerate.expireStopTimer(pad); }
+	};
+	Subject referenceAccelerateSubject {
+		referenceAccelerate
+		, [&referenceAccelerate]() { referenceAccelerate.tick(); }
+		, [&referenceAccelerate](int pad) { referenceAccelerate.expireStopTimer(pad); }
+	};
+	ok = compare("AccelerateStrategy", accelerateSubject, referenceAccelerateSubject, steps(count, true), count)
+			&& ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+/// Microbenchmark of strategies. The same pseudo-random key sequence is fed to a strategy and to a reference copy
+/// of its previous container-based implementation. Produced frames are compared, so the benchmark doubles as an
+/// equivalence check, and cost of an event is printed for both. Timers of AccelerateStrategy are simulated, so its
+/// ticks are interleaved with key events deterministically.
+class StrategyBenchmark
+{
+public:
+	/// Runs benchmark with given number of key events, returns process exit code: 0 if implementations agree
+	static int run(int events);
+};
@@ -0,0 +1,34 @@
+# Copyright 2026 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+include(../tests.pri)
+
+QT = core network testlib
+TARGET = tst_connectionManager
+
+SOURCES += \
+	$$PWD/tst_connectionManager.cpp \
+	$$GAMEPAD_DIR/connectionManager.cpp \
+	$$GAMEPAD_DIR/commandCodec.cpp \
+	$$GAMEPAD_DIR/sendQueue.cpp \
+	$$GAMEPAD_DIR/linkStatistics.cpp
+
+HEADERS += \
+	$$GAMEPAD_DIR/connectionManager.h \
+	$$GAMEPAD_DIR/commandCodec.h \
+	$$GAMEPAD_DIR/commandFrame.h \
+	$$GAMEPAD_DIR/gamepadCommand.h \
+	$$GAMEPAD_DIR/sendQueue.h \
+	$$GAMEPAD_DIR/linkStatistics.h \
+	$$GAMEPAD_DIR/encodedFrame.h
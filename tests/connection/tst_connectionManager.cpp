@@ -0,0 +1,266 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QSettings>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtTest/QtTest>
+
+#include "commandCodec.h"
+#include "connectionManager.h"
+
+/// Runs ConnectionManager against a robot served by QTcpServer on the loopback interface
+class ConnectionManagerTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+
+	void sendsCommandsInTextProtocol();
+	void negotiatesBinaryProtocol();
+	void reportsUnreachableRobot();
+	void measuresLinkQualityByEchoes();
+	void doesNotProbeTextRobots();
+	void detectsSilentRobot();
+	void reconnectsAfterDrop();
+
+	void benchmarkWriteFrame();
+
+private:
+	/// Creates manager for the robot and waits until it connects
+	void connectManager();
+
+	/// Accepts connection of the manager as the robot
+	void acceptPeer();
+
+	/// Decodes commands received by the robot, answers protocol negotiation and pings like the robot does
+	void readPeer();
+
+	/// Sends command to the manager in the protocol it was sent to the robot with
+	void reply(const GamepadCommand &command);
+
+	QTemporaryDir mDir;
+	QScopedPointer<QSettings> mSettings;
+	QTcpServer mServer;
+	QScopedPointer<ConnectionManager> mManager;
+
+	QTcpSocket *mPeer {}; // Has ownership
+	CommandCodec mPeerCodec;
+	bool mEcho {};
+	QByteArray mReceivedBytes;
+	int mDecodedBytes {};
+	QVector<GamepadCommand> mReceived;
+
+	/// Protocols reported by the manager, true for binary
+	QVector<bool> mProtocols;
+};
+
+void ConnectionManagerTest::init()
+{
+	QVERIFY(mDir.isValid());
+	mSettings.reset(new QSettings(mDir.filePath("gamepad.ini"), QSettings::IniFormat));
+	mSettings->clear();
+	QVERIFY(mServer.listen(QHostAddress::LocalHost));
+	mSettings->setValue("gamepadIp", "127.0.0.1");
+	mSettings->setValue("gamepadPort", mServer.serverPort());
+	// Pings and dead peer detection are enabled by tests which need them
+	mSettings->setValue("pingInterval", 60 * 1000);
+	mSettings->setValue("deadPeerTimeout", 0);
+	mPeerCodec.setProtocol(CommandCodec::Protocol::text);
+	mEcho = false;
+	mReceivedBytes.clear();
+	mDecodedBytes = 0;
+	mReceived.clear();
+	mProtocols.clear();
+}
+
+void ConnectionManagerTest::cleanup()
+{
+	mManager.reset();
+	delete mPeer;
+	mPeer = nullptr;
+	mServer.close();
+	mSettings.reset();
+}
+
+void ConnectionManagerTest::connectManager()
+{
+	mManager.reset(new ConnectionManager(mSettings.data()));
+	mManager->init();
+	connect(mManager.data(), &ConnectionManager::protocolChanged, this, [this](bool binary) {
+		mProtocols.append(binary);
+	});
+
+	mManager->reconnectToHost();
+	acceptPeer();
+	QTRY_VERIFY(mManager->isConnected());
+}
+
+void ConnectionManagerTest::acceptPeer()
+{
+	QTRY_VERIFY(mServer.hasPendingConnections());
+	delete mPeer;
+	mPeer = mServer.nextPendingConnection();
+	mPeerCodec.setProtocol(CommandCodec::Protocol::text);
+	connect(mPeer, &QTcpSocket::readyRead, this, &ConnectionManagerTest::readPeer);
+}
+
+void ConnectionManagerTest::readPeer()
+{
+	mReceivedBytes.append(mPeer->readAll());
+	GamepadCommand command;
+	while (const int consumed = CommandCodec::decode(mReceivedBytes.constData() + mDecodedBytes
+			, mReceivedBytes.size() - mDecodedBytes, command)) {
+		mDecodedBytes += consumed;
+		mReceived.append(command);
+		if (command.type == GamepadCommand::Type::protocol
+				&& command.value == CommandCodec::binaryProtocolVersion) {
+			reply(command);
+			mPeerCodec.setProtocol(CommandCodec::Protocol::binary);
+		} else if (command.type == GamepadCommand::Type::ping && mEcho) {
+			reply(GamepadCommand::echo(command.value));
+		}
+	}
+}
+
+void ConnectionManagerTest::reply(const GamepadCommand &command)
+{
+	QByteArray data;
+	mPeerCodec.encode(command, data);
+	mPeer->write(data);
+}
+
+void ConnectionManagerTest::sendsCommandsInTextProtocol()
+{
+	connectManager();
+	mManager->write(GamepadCommand::pad(1, 10, -20));
+	QTRY_COMPARE(mReceived.size(), 1);
+	QVERIFY(mReceivedBytes.startsWith("pad 1 10 -20"));
+	QCOMPARE(mReceived[0].type, GamepadCommand::Type::pad);
+	QCOMPARE(static_cast<int>(mReceived[0].x), 10);
+	QCOMPARE(static_cast<int>(mReceived[0].y), -20);
+
+	CommandFrame frame;
+	frame.append(GamepadCommand::pad(2, 0, 100));
+	frame.append(GamepadCommand::button(3));
+	mManager->writeFrame(frame);
+	QTRY_COMPARE(mReceived.size(), 3);
+	QCOMPARE(mReceived[1].type, GamepadCommand::Type::pad);
+	QCOMPARE(static_cast<int>(mReceived[1].id), 2);
+	QCOMPARE(mReceived[2].type, GamepadCommand::Type::button);
+	QCOMPARE(static_cast<int>(mReceived[2].id), 3);
+}
+
+void ConnectionManagerTest::negotiatesBinaryProtocol()
+{
+	mSettings->setValue("binaryProtocol", true);
+	connectManager();
+	QTRY_COMPARE(mProtocols, QVector<bool>({false, true}));
+	QCOMPARE(mReceived[0].type, GamepadCommand::Type::protocol);
+
+	// Binary commands start with their length instead of a letter
+	const int offset = mReceivedBytes.size();
+	mManager->write(GamepadCommand::pad(1, -100, 50));
+	QTRY_COMPARE(mReceived.size(), 2);
+	QVERIFY(mReceivedBytes.at(offset) >= 1 && mReceivedBytes.at(offset) <= CommandCodec::maxFrameLength);
+	QCOMPARE(static_cast<int>(mReceived[1].x), -100);
+	QCOMPARE(static_cast<int>(mReceived[1].y), 50);
+}
+
+void ConnectionManagerTest::reportsUnreachableRobot()
+{
+	mServer.close();
+	mManager.reset(new ConnectionManager(mSettings.data()));
+	mManager->init();
+	QSignalSpy failures(mManager.data(), &ConnectionManager::connectionFailed);
+	mManager->reconnectToHost();
+	QTRY_COMPARE(failures.count(), 1);
+	QVERIFY(!mManager->isConnected());
+}
+
+void ConnectionManagerTest::measuresLinkQualityByEchoes()
+{
+	mSettings->setValue("binaryProtocol", true);
+	mSettings->setValue("pingInterval", 20);
+	mEcho = true;
+	connectManager();
+	int updates = 0;
+	connect(mManager.data(), &ConnectionManager::linkQualityChanged, this, [&updates]() { ++updates; });
+	QTRY_VERIFY(updates >= 3);
+}
+
+void ConnectionManagerTest::doesNotProbeTextRobots()
+{
+	mSettings->setValue("pingInterval", 20);
+	mEcho = true;
+	connectManager();
+	mManager->write(GamepadCommand::button(1));
+	QTRY_COMPARE(mReceived.size(), 1);
+	QTest::qWait(200);
+	mManager->write(GamepadCommand::button(2));
+	QTRY_COMPARE(mReceived.size(), 2);
+	QCOMPARE(mReceived[1].type, GamepadCommand::Type::button);
+}
+
+void ConnectionManagerTest::detectsSilentRobot()
+{
+	mSettings->setValue("binaryProtocol", true);
+	mSettings->setValue("deadPeerTimeout", 100);
+	mEcho = true;
+	connectManager();
+	QSignalSpy losses(mManager.data(), &ConnectionManager::peerLost);
+	int updates = 0;
+	connect(mManager.data(), &ConnectionManager::linkQualityChanged, this, [&updates]() { ++updates; });
+	QTRY_VERIFY(updates >= 3);
+	QCOMPARE(losses.count(), 0);
+
+	// Socket is open, but echoes stop, like when the robot hangs
+	mEcho = false;
+	QTRY_COMPARE(losses.count(), 1);
+}
+
+void ConnectionManagerTest::reconnectsAfterDrop()
+{
+	connectManager();
+	QSignalSpy reconnections(mManager.data(), &ConnectionManager::reconnected);
+	mPeer->abort();
+	QTRY_VERIFY(!mManager->isConnected());
+
+	// Commands written while reconnecting wait for the new connection
+	mManager->write(GamepadCommand::button(5));
+	acceptPeer();
+	QTRY_COMPARE(reconnections.count(), 1);
+	QTRY_COMPARE(mReceived.size(), 1);
+	QCOMPARE(mReceived[0].type, GamepadCommand::Type::button);
+}
+
+void ConnectionManagerTest::benchmarkWriteFrame()
+{
+	// Everything goes to the socket, congestion handling is not measured
+	mSettings->setValue("congestionThreshold", 1 << 30);
+	connectManager();
+	CommandFrame frame;
+	frame.append(GamepadCommand::pad(1, 37, -64));
+	frame.append(GamepadCommand::pad(2, -100, 100));
+	QBENCHMARK {
+		mManager->writeFrame(frame);
+	}
+}
+
+QTEST_GUILESS_MAIN(ConnectionManagerTest)
+
+#include "tst_connectionManager.moc"
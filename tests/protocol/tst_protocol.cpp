@@ -0,0 +1,329 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QVector>
+#include <QtTest/QtTest>
+
+#include "commandCodec.h"
+#include "padDeltaFilter.h"
+#include "sendQueue.h"
+
+namespace {
+
+/// Commands as they go to the robot in text protocol, separated by "; "
+QString text(const QVector<GamepadCommand> &commands)
+{
+	const CommandCodec codec;
+	QByteArray line;
+	for (const auto &command : commands) {
+		QByteArray encoded;
+		codec.encode(command, encoded);
+		if (!line.isEmpty()) {
+			line.append("; ");
+		}
+
+		line.append(encoded.trimmed());
+	}
+
+	return QString::fromLatin1(line);
+}
+
+QString text(const CommandFrame &frame)
+{
+	QVector<GamepadCommand> commands;
+	for (const auto &command : frame) {
+		commands.append(command);
+	}
+
+	return text(commands);
+}
+
+/// Frame of given commands
+CommandFrame frameOf(std::initializer_list<GamepadCommand> commands)
+{
+	CommandFrame frame;
+	for (const auto &command : commands) {
+		frame.append(command);
+	}
+
+	return frame;
+}
+
+/// Decodes all complete commands of data, returns them and the number of bytes left undecoded
+QVector<GamepadCommand> decodeAll(const QByteArray &data, int &left)
+{
+	QVector<GamepadCommand> result;
+	int position = 0;
+	GamepadCommand command;
+	while (const int consumed = CommandCodec::decode(data.constData() + position, data.size() - position, command)) {
+		position += consumed;
+		result.append(command);
+	}
+
+	left = data.size() - position;
+	return result;
+}
+
+}
+
+/// Checks SendQueue, CommandCodec and PadDeltaFilter, the stages a command passes on its way to the socket
+class ProtocolTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void queueKeepsNewestPadPosition();
+	void queueKeepsArrivalOrder();
+	void queueMergesKeepalivesAndSkipsProbes();
+	void queueDropsReliableCommandsOverCap();
+	void queueStaysCompactWhileStalled();
+
+	void codecWaitsForCompleteTextCommand();
+	void codecWaitsForCompleteBinaryFrame();
+	void codecReportsMalformedTextAsInvalid();
+	void codecReportsMalformedBinaryAsInvalid();
+	void codecDropsLinesWithoutNewline();
+
+	void filterSuppressesRepeatedPositions();
+	void filterRefreshesHeldPad();
+	void filterWithZeroIntervalPassesEverything();
+};
+
+void ProtocolTest::queueKeepsNewestPadPosition()
+{
+	SendQueue queue;
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 10, 0)}));
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 20, 0), GamepadCommand::pad(2, 5, 5)}));
+	queue.enqueue(frameOf({GamepadCommand::padUp(1)}));
+	QCOMPARE(queue.size(), 2);
+	QCOMPARE(queue.dropped(), 2);
+	QCOMPARE(text(queue.takeAll()), QString("pad 2 5 5; pad 1 up"));
+	QVERIFY(queue.isEmpty());
+	QCOMPARE(queue.dropped(), 2);
+}
+
+void ProtocolTest::queueKeepsArrivalOrder()
+{
+	SendQueue queue;
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 10, 0), GamepadCommand::button(3)}));
+	queue.enqueue(frameOf({GamepadCommand::pad(2, 1, 1), GamepadCommand::button(4)}));
+	QCOMPARE(text(queue.takeAll()), QString("pad 1 10 0; btn 3; pad 2 1 1; btn 4"));
+
+	// Replaced position goes where the newest one came, after the button pressed meanwhile
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 10, 0), GamepadCommand::button(3)}));
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 30, 0)}));
+	QCOMPARE(text(queue.takeAll()), QString("btn 3; pad 1 30 0"));
+}
+
+void ProtocolTest::queueMergesKeepalivesAndSkipsProbes()
+{
+	SendQueue queue;
+	queue.enqueue(frameOf({GamepadCommand::keepalive(4000), GamepadCommand::button(1)}));
+	queue.enqueue(frameOf({GamepadCommand::ping(7), GamepadCommand::keepalive(3000)}));
+	QCOMPARE(queue.size(), 2);
+	QCOMPARE(queue.dropped(), 0);
+	QCOMPARE(text(queue.takeAll()), QString("btn 1; keepalive 3000"));
+
+	queue.enqueue(frameOf({GamepadCommand::ping(8)}));
+	QVERIFY(queue.isEmpty());
+}
+
+void ProtocolTest::queueDropsReliableCommandsOverCap()
+{
+	SendQueue queue;
+	const int extra = 5;
+	for (int i = 0; i < SendQueue::maxReliable + extra; ++i) {
+		queue.enqueue(frameOf({GamepadCommand::button(i % 5 + 1)}));
+	}
+
+	// Pads have their own slots, so they still fit
+	queue.enqueue(frameOf({GamepadCommand::pad(1, 1, 1)}));
+	QCOMPARE(queue.size(), SendQueue::maxReliable + 1);
+	QCOMPARE(queue.dropped(), extra);
+	const auto &commands = queue.takeAll();
+	QCOMPARE(commands.size(), SendQueue::maxReliable + 1);
+	QCOMPARE(commands.last().type, GamepadCommand::Type::pad);
+}
+
+void ProtocolTest::queueStaysCompactWhileStalled()
+{
+	SendQueue queue;
+	const int ticks = 10000;
+	queue.enqueue(frameOf({GamepadCommand::button(1)}));
+	for (int i = 0; i < ticks; ++i) {
+		queue.enqueue(frameOf({GamepadCommand::pad(1, i % 100, 0), GamepadCommand::pad(2, 0, i % 100)}));
+	}
+
+	queue.enqueue(frameOf({GamepadCommand::button(2)}));
+	QCOMPARE(queue.size(), 4);
+	QCOMPARE(queue.dropped(), 2 * (ticks - 1));
+	QCOMPARE(text(queue.takeAll()), QString("btn 1; pad 1 99 0; pad 2 0 99; btn 2"));
+}
+
+void ProtocolTest::codecWaitsForCompleteTextCommand()
+{
+	const QByteArray data = "pad 1 10 -20 \n";
+	GamepadCommand command;
+	for (int size = 0; size < data.size(); ++size) {
+		QCOMPARE(CommandCodec::decode(data.constData(), size, command), 0);
+	}
+
+	QCOMPARE(CommandCodec::decode(data.constData(), data.size(), command), data.size());
+	QCOMPARE(command.type, GamepadCommand::Type::pad);
+	QCOMPARE(static_cast<int>(command.x), 10);
+	QCOMPARE(static_cast<int>(command.y), -20);
+}
+
+void ProtocolTest::codecWaitsForCompleteBinaryFrame()
+{
+	const CommandCodec codec(CommandCodec::Protocol::binary);
+	auto pad = GamepadCommand::pad(2, -100, 100);
+	pad.sequence = 0x1234;
+	QByteArray data;
+	codec.encode(pad, data);
+	GamepadCommand command;
+	for (int size = 0; size < data.size(); ++size) {
+		QCOMPARE(CommandCodec::decode(data.constData(), size, command), 0);
+	}
+
+	QCOMPARE(CommandCodec::decode(data.constData(), data.size(), command), data.size());
+	QCOMPARE(command.type, GamepadCommand::Type::pad);
+	QCOMPARE(static_cast<int>(command.id), 2);
+	QCOMPARE(static_cast<int>(command.x), -100);
+	QCOMPARE(static_cast<int>(command.y), 100);
+	QCOMPARE(static_cast<int>(command.sequence), 0x1234);
+}
+
+void ProtocolTest::codecReportsMalformedTextAsInvalid()
+{
+	int left = 0;
+	const auto &commands = decodeAll("hello\npad x 1 2\npad 1 2\nbtn\n\npad 1 500 -500\n", left);
+	QCOMPARE(left, 0);
+	QCOMPARE(commands.size(), 6);
+	for (int i = 0; i < 5; ++i) {
+		QCOMPARE(commands[i].type, GamepadCommand::Type::invalid);
+	}
+
+	// Positions out of range are clamped rather than dropped
+	QCOMPARE(commands[5].type, GamepadCommand::Type::pad);
+	QCOMPARE(static_cast<int>(commands[5].x), 100);
+	QCOMPARE(static_cast<int>(commands[5].y), -100);
+}
+
+void ProtocolTest::codecReportsMalformedBinaryAsInvalid()
+{
+	QByteArray data;
+
+	// Length does not match the type, then an unknown type, then a valid button
+	data.append(static_cast<char>(3));
+	data.append(static_cast<char>(GamepadCommand::Type::pad));
+	data.append(2, '\0');
+	data.append(static_cast<char>(5));
+	data.append(static_cast<char>(99));
+	data.append(4, '\0');
+	const CommandCodec codec(CommandCodec::Protocol::binary);
+	codec.encode(GamepadCommand::button(3), data);
+
+	int left = 0;
+	const auto &commands = decodeAll(data, left);
+	QCOMPARE(left, 0);
+	QCOMPARE(commands.size(), 3);
+	QCOMPARE(commands[0].type, GamepadCommand::Type::invalid);
+	QCOMPARE(commands[1].type, GamepadCommand::Type::invalid);
+	QCOMPARE(commands[2].type, GamepadCommand::Type::button);
+	QCOMPARE(static_cast<int>(commands[2].id), 3);
+}
+
+void ProtocolTest::codecDropsLinesWithoutNewline()
+{
+	GamepadCommand command;
+	const QByteArray garbage(CommandCodec::maxLineLength - 1, 'x');
+	QCOMPARE(CommandCodec::decode(garbage.constData(), garbage.size(), command), 0);
+
+	// A line too long to be a command is dropped in pieces, decoding goes on after its newline
+	int left = 0;
+	const auto &commands = decodeAll(QByteArray(3 * CommandCodec::maxLineLength + 10, 'x') + "\npad 1 0 0 \n", left);
+	QCOMPARE(left, 0);
+	QCOMPARE(commands.size(), 5);
+	for (int i = 0; i < 4; ++i) {
+		QCOMPARE(commands[i].type, GamepadCommand::Type::invalid);
+	}
+
+	QCOMPARE(commands[4].type, GamepadCommand::Type::pad);
+}
+
+void ProtocolTest::filterSuppressesRepeatedPositions()
+{
+	PadDeltaFilter filter;
+	filter.setRefreshInterval(60 * 1000);
+	QStringList frames;
+	connect(&filter, &PadDeltaFilter::framePrepared, this, [&frames](const CommandFrame &frame) {
+		frames.append(text(frame));
+	});
+
+	filter.process(frameOf({GamepadCommand::pad(1, 50, 0)}));
+	filter.process(frameOf({GamepadCommand::pad(1, 50, 0)}));
+	filter.process(frameOf({GamepadCommand::pad(1, 50, 0), GamepadCommand::button(2)}));
+	filter.process(frameOf({GamepadCommand::pad(1, 60, 0)}));
+	filter.process(frameOf({GamepadCommand::padUp(1)}));
+	filter.process(frameOf({GamepadCommand::padUp(1)}));
+	filter.process(frameOf({GamepadCommand::pad(1, 60, 0)}));
+	QCOMPARE(frames, QStringList({"pad 1 50 0", "btn 2", "pad 1 60 0", "pad 1 up", "pad 1 up", "pad 1 60 0"}));
+	QCOMPARE(filter.sentPads(), 3);
+	QCOMPARE(filter.suppressedPads(), 2);
+
+	// After reset the robot may have anything, so the same position is sent again
+	filter.reset();
+	filter.process(frameOf({GamepadCommand::pad(1, 60, 0)}));
+	QCOMPARE(frames.size(), 7);
+}
+
+void ProtocolTest::filterRefreshesHeldPad()
+{
+	PadDeltaFilter filter;
+	filter.setRefreshInterval(20);
+	QStringList frames;
+	connect(&filter, &PadDeltaFilter::framePrepared, this, [&frames](const CommandFrame &frame) {
+		frames.append(text(frame));
+	});
+
+	filter.process(frameOf({GamepadCommand::pad(2, -30, 40)}));
+	QTRY_VERIFY(frames.size() >= 3);
+	for (const auto &frame : frames) {
+		QCOMPARE(frame, QString("pad 2 -30 40"));
+	}
+
+	// Released pad is not refreshed
+	filter.process(frameOf({GamepadCommand::padUp(2)}));
+	const int released = frames.size();
+	QTest::qWait(100);
+	QCOMPARE(frames.size(), released);
+	QCOMPARE(frames.last(), QString("pad 2 up"));
+}
+
+void ProtocolTest::filterWithZeroIntervalPassesEverything()
+{
+	PadDeltaFilter filter;
+	filter.setRefreshInterval(0);
+	int frames = 0;
+	connect(&filter, &PadDeltaFilter::framePrepared, this, [&frames]() { ++frames; });
+	filter.process(frameOf({GamepadCommand::pad(1, 50, 0)}));
+	filter.process(frameOf({GamepadCommand::pad(1, 50, 0)}));
+	QCOMPARE(frames, 2);
+	QCOMPARE(filter.suppressedPads(), 0);
+}
+
+QTEST_GUILESS_MAIN(ProtocolTest)
+
+#include "tst_protocol.moc"
@@ -0,0 +1,431 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QVector>
+#include <QtGui/QKeyEvent>
+#include <QtTest/QtTest>
+
+#include "accelerateStrategy.h"
+#include "commandCodec.h"
+#include "controlKeys.h"
+#include "inputRecorder.h"
+#include "standardStrategy.h"
+
+namespace {
+
+/// Commands of a frame as they go to the robot in text protocol, separated by "; "
+QString text(const CommandFrame &frame)
+{
+	const CommandCodec codec;
+	QByteArray line;
+	for (const auto &command : frame) {
+		QByteArray encoded;
+		codec.encode(command, encoded);
+		if (!line.isEmpty()) {
+			line.append("; ");
+		}
+
+		line.append(encoded.trimmed());
+	}
+
+	return QString::fromLatin1(line);
+}
+
+void press(Strategy &strategy, int key)
+{
+	QKeyEvent event(QEvent::KeyPress, key, Qt::NoModifier);
+	strategy.processEvent(&event);
+}
+
+void release(Strategy &strategy, int key)
+{
+	QKeyEvent event(QEvent::KeyRelease, key, Qt::NoModifier);
+	strategy.processEvent(&event);
+}
+
+/// Collects frames emitted by a strategy
+class FrameLog
+{
+public:
+	explicit FrameLog(Strategy &strategy)
+	{
+		QObject::connect(&strategy, &Strategy::framePrepared, &strategy, [this](const CommandFrame &frame) {
+			mFrames.append(frame);
+		});
+	}
+
+	int size() const
+	{
+		return mFrames.size();
+	}
+
+	/// Text of the last frame, empty if there were none
+	QString last() const
+	{
+		return mFrames.isEmpty() ? QString() : text(mFrames.last());
+	}
+
+	/// First command of the last frame
+	GamepadCommand lastCommand() const
+	{
+		return mFrames.isEmpty() ? GamepadCommand() : mFrames.last().at(0);
+	}
+
+	QStringList texts() const
+	{
+		QStringList result;
+		for (const auto &frame : mFrames) {
+			result << text(frame);
+		}
+
+		return result;
+	}
+
+private:
+	QVector<CommandFrame> mFrames;
+};
+
+/// Accelerate strategy on virtual clock with one second ramp, stop timer of a pad fires 700 ms after its last key
+class VirtualAccelerateStrategy : public AccelerateStrategy
+{
+public:
+	VirtualAccelerateStrategy()
+		: AccelerateStrategy(300)
+	{
+		setRampTime(1000);
+		setVirtualClock(true);
+	}
+
+	/// Moves virtual clock by given number of milliseconds
+	void advance(int ms)
+	{
+		advanceClock(ms * 1000LL);
+	}
+};
+
+/// Writes data into file of given name in the directory, returns path of the file
+QString writeFile(const QTemporaryDir &dir, const QString &name, const QByteArray &data)
+{
+	const auto &path = dir.filePath(name);
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+		return QString();
+	}
+
+	return path;
+}
+
+/// Recording header followed by one record 16 us after start with given flags, argument and stick coordinates
+QByteArray recording(quint8 flags, quint8 argument, qint8 x = 0, qint8 y = 0)
+{
+	QByteArray data("TGIR\x01");
+	data.append(QByteArray::fromHex("10000000"));
+	data.append(static_cast<char>(flags));
+	data.append(static_cast<char>(argument));
+	data.append(static_cast<char>(x));
+	data.append(static_cast<char>(y));
+	return data;
+}
+
+}
+
+class StrategiesTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void standardPadFollowsKeys();
+	void standardSendsBothPadsInOneFrame();
+	void standardResetReleasesHeldPads();
+	void stickTakesPadOverFromKeys();
+	void accelerateRampsUpPower();
+	void accelerateStopTimerReleasesPad();
+	void accelerateReleasedAxisDecays();
+	void accelerateResetReleasesPadRightAway();
+	void accelerateIsReproducibleOnVirtualClock();
+	void recordingIsReadBack();
+	void recordingLoadRejectsMalformedFiles();
+
+	void benchmarkStandardKey();
+	void benchmarkAccelerateTick();
+};
+
+void StrategiesTest::standardPadFollowsKeys()
+{
+	StandardStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_W);
+	QCOMPARE(log.last(), QString("pad 1 0 100"));
+	press(strategy, Qt::Key_D);
+	QCOMPARE(log.last(), QString("pad 1 100 100"));
+	release(strategy, Qt::Key_W);
+	QCOMPARE(log.last(), QString("pad 1 up"));
+	press(strategy, Qt::Key_3);
+	QCOMPARE(log.last(), QString("pad 1 100 0; btn 3"));
+
+	const int frames = log.size();
+	press(strategy, Qt::Key_Q);
+	release(strategy, Qt::Key_Q);
+	QCOMPARE(log.size(), frames + 1);
+}
+
+void StrategiesTest::standardSendsBothPadsInOneFrame()
+{
+	StandardStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_W);
+	press(strategy, Qt::Key_Left);
+	QCOMPARE(log.last(), QString("pad 1 0 100; pad 2 -100 0"));
+}
+
+void StrategiesTest::standardResetReleasesHeldPads()
+{
+	StandardStrategy strategy;
+	FrameLog log(strategy);
+
+	strategy.reset();
+	QCOMPARE(log.size(), 0);
+
+	press(strategy, Qt::Key_S);
+	press(strategy, Qt::Key_Down);
+	strategy.reset();
+	QCOMPARE(log.last(), QString("pad 1 up; pad 2 up"));
+}
+
+void StrategiesTest::stickTakesPadOverFromKeys()
+{
+	StandardStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_W);
+	strategy.processStick(GamepadCommand::pad(1, 30, -40));
+	QCOMPARE(log.last(), QString("pad 1 30 -40"));
+	QVERIFY(strategy.isStickHeld(1));
+
+	// Keys of the held pad are silent, the other pad is not affected
+	const int frames = log.size();
+	release(strategy, Qt::Key_W);
+	press(strategy, Qt::Key_D);
+	QCOMPARE(log.size(), frames);
+	press(strategy, Qt::Key_Left);
+	QCOMPARE(log.last(), QString("pad 2 -100 0"));
+	strategy.reset();
+	QCOMPARE(log.last(), QString("pad 2 up"));
+
+	strategy.processStick(GamepadCommand::padUp(1));
+	QCOMPARE(log.last(), QString("pad 1 up"));
+	strategy.processStick(GamepadCommand::padUp(1));
+	QCOMPARE(log.size(), frames + 3);
+	press(strategy, Qt::Key_D);
+	QCOMPARE(log.last(), QString("pad 1 100 0"));
+}
+
+void StrategiesTest::accelerateRampsUpPower()
+{
+	VirtualAccelerateStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_D);
+	QCOMPARE(log.size(), 0);
+	strategy.advance(20);
+	QCOMPARE(log.last(), QString("pad 1 2 0"));
+	strategy.advance(480);
+	QCOMPARE(log.size(), 25);
+	QCOMPARE(log.last(), QString("pad 1 50 0"));
+	strategy.advance(1000);
+	QCOMPARE(log.last(), QString("pad 1 100 0"));
+}
+
+void StrategiesTest::accelerateStopTimerReleasesPad()
+{
+	VirtualAccelerateStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_W);
+	strategy.advance(500);
+	release(strategy, Qt::Key_W);
+	const int frames = log.size();
+
+	// The last tick with the key held was at 500 ms, so the pad stops at 1200 ms and nothing is sent before
+	strategy.advance(690);
+	QCOMPARE(log.size(), frames);
+	strategy.advance(20);
+	QCOMPARE(log.size(), frames + 1);
+	QCOMPARE(log.last(), QString("pad 1 up"));
+
+	strategy.advance(2000);
+	QCOMPARE(log.size(), frames + 1);
+}
+
+void StrategiesTest::accelerateReleasedAxisDecays()
+{
+	VirtualAccelerateStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_W);
+	press(strategy, Qt::Key_D);
+	strategy.advance(400);
+	QCOMPARE(log.last(), QString("pad 1 40 40"));
+	release(strategy, Qt::Key_D);
+
+	// Power of released axis is kept for speed ms and falls to zero on the first tick after that
+	strategy.advance(300);
+	QCOMPARE(static_cast<int>(log.lastCommand().x), 40);
+	strategy.advance(20);
+	QCOMPARE(log.last(), QString("pad 1 0 72"));
+}
+
+void StrategiesTest::accelerateResetReleasesPadRightAway()
+{
+	VirtualAccelerateStrategy strategy;
+	FrameLog log(strategy);
+
+	press(strategy, Qt::Key_Up);
+	strategy.advance(100);
+	strategy.reset();
+	QCOMPARE(log.last(), QString("pad 2 up"));
+
+	const int frames = log.size();
+	strategy.advance(2000);
+	QCOMPARE(log.size(), frames);
+}
+
+void StrategiesTest::accelerateIsReproducibleOnVirtualClock()
+{
+	const auto run = []() {
+		VirtualAccelerateStrategy strategy;
+		FrameLog log(strategy);
+		press(strategy, Qt::Key_W);
+		strategy.advance(137);
+		press(strategy, Qt::Key_Right);
+		strategy.advance(251);
+		release(strategy, Qt::Key_W);
+		press(strategy, Qt::Key_1);
+		strategy.advance(333);
+		release(strategy, Qt::Key_Right);
+		strategy.advance(1500);
+		return log.texts();
+	};
+
+	const auto frames = run();
+	QVERIFY(frames.contains("pad 1 up"));
+	QVERIFY(frames.contains("pad 2 up"));
+	QCOMPARE(run(), frames);
+}
+
+void StrategiesTest::recordingIsReadBack()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const auto &path = dir.filePath("input.tgir");
+	{
+		InputRecorder recorder;
+		QVERIFY(recorder.open(path));
+		VirtualAccelerateStrategy strategy;
+		recorder.recordStrategy(strategy);
+		recorder.recordKey(QKeyEvent(QEvent::KeyPress, Qt::Key_Up, Qt::NoModifier));
+		recorder.recordKey(QKeyEvent(QEvent::KeyPress, Qt::Key_Q, Qt::NoModifier));
+		recorder.recordKey(QKeyEvent(QEvent::KeyRelease, Qt::Key_Up, Qt::NoModifier, QString(), true));
+		recorder.recordStick(GamepadCommand::pad(2, -50, 60));
+		recorder.recordStick(GamepadCommand::padUp(1));
+		recorder.recordReset();
+	}
+
+	QVector<RecordedInput> records;
+	QString error;
+	QVERIFY2(InputRecorder::load(path, records, error), qPrintable(error));
+
+	// Keys gamepad does not react to are not recorded
+	QCOMPARE(records.size(), 6);
+	QCOMPARE(records[0].kind, RecordedInput::Kind::strategy);
+	QCOMPARE(records[0].argument, static_cast<int>(Strategies::accelerateStrategy));
+	QCOMPARE(records[1].kind, RecordedInput::Kind::key);
+	QCOMPARE(records[1].type, QEvent::KeyPress);
+	QCOMPARE(records[1].argument, static_cast<int>(Qt::Key_Up));
+	QVERIFY(!records[1].autoRepeat);
+	QCOMPARE(records[2].type, QEvent::KeyRelease);
+	QVERIFY(records[2].autoRepeat);
+	QCOMPARE(records[3].kind, RecordedInput::Kind::stick);
+	QCOMPARE(text(CommandFrame(records[3].stick)), QString("pad 2 -50 60"));
+	QCOMPARE(text(CommandFrame(records[4].stick)), QString("pad 1 up"));
+	QCOMPARE(records[5].kind, RecordedInput::Kind::reset);
+	for (int i = 1; i < records.size(); ++i) {
+		QVERIFY(records[i].time >= records[i - 1].time);
+	}
+}
+
+void StrategiesTest::recordingLoadRejectsMalformedFiles()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	QVector<RecordedInput> records;
+	QString error;
+
+	QVERIFY(!InputRecorder::load(dir.filePath("missing.tgir"), records, error));
+	QVERIFY2(error.startsWith("Can not read input recording"), qPrintable(error));
+
+	const auto valid = recording(0, ControlKeys::w);
+	QVERIFY(InputRecorder::load(writeFile(dir, "valid.tgir", valid), records, error));
+	QCOMPARE(records.size(), 1);
+
+	auto badMagic = valid;
+	badMagic[3] = 'X';
+	auto newerVersion = valid;
+	newerVersion[4] = 2;
+	const QList<QPair<QByteArray, QString>> malformed = {
+		{ badMagic, "is not an input recording of this version" }
+		, { newerVersion, "is not an input recording of this version" }
+		, { valid.left(valid.size() - 1), "is not an input recording of this version" }
+		, { valid.left(4), "is not an input recording of this version" }
+		, { recording(0, ControlKeys::count), "has unknown key at offset 5" }
+		, { recording(2, static_cast<quint8>(Strategies::TOTAL)), "has unknown strategy at offset 5" }
+		, { recording(3, 0), "has unknown stick at offset 5" }
+		, { valid + recording(3, 3).mid(5), "has unknown stick at offset 13" }
+	};
+
+	for (int i = 0; i < malformed.size(); ++i) {
+		const auto &path = writeFile(dir, QString("malformed%1.tgir").arg(i), malformed[i].first);
+		QVERIFY(!path.isEmpty());
+		QVERIFY2(!InputRecorder::load(path, records, error), qPrintable(path));
+		QVERIFY2(error.endsWith(malformed[i].second), qPrintable(error));
+	}
+}
+
+void StrategiesTest::benchmarkStandardKey()
+{
+	StandardStrategy strategy;
+	QKeyEvent pressEvent(QEvent::KeyPress, Qt::Key_W, Qt::NoModifier);
+	QKeyEvent releaseEvent(QEvent::KeyRelease, Qt::Key_W, Qt::NoModifier);
+	QBENCHMARK {
+		strategy.processEvent(&pressEvent);
+		strategy.processEvent(&releaseEvent);
+	}
+}
+
+void StrategiesTest::benchmarkAccelerateTick()
+{
+	VirtualAccelerateStrategy strategy;
+	press(strategy, Qt::Key_W);
+	press(strategy, Qt::Key_Left);
+	QBENCHMARK {
+		strategy.advance(20);
+	}
+}
+
+QTEST_GUILESS_MAIN(StrategiesTest)
+
+#include "tst_strategies.moc"
@@ -0,0 +1,30 @@
+# Copyright 2026 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Common settings of test projects, sources of gamepad are compiled into them from the parent directory
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic -Wold-style-cast -Wconversion
+QMAKE_CXXFLAGS += -Winit-self -Wunreachable-code
+QMAKE_CXXFLAGS += -Werror -Wno-conversion
+QMAKE_CXXFLAGS += -Wno-error=deprecated-declarations
+QMAKE_CXXFLAGS += -isystem "$$[QT_INSTALL_HEADERS]"
+!lessThan(QT_MAJOR_VERSION, 6):DEFINES += TRIK_USE_QT6
+
+QT += testlib
+CONFIG += console c++14 testcase
+CONFIG -= app_bundle
+TEMPLATE = app
+
+GAMEPAD_DIR = $$PWD/..
+INCLUDEPATH += $$GAMEPAD_DIR
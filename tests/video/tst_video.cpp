@@ -0,0 +1,319 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QBuffer>
+#include <QtCore/QThreadPool>
+#include <QtGui/QImage>
+#include <QtTest/QtTest>
+
+#include "frameConverter.h"
+#include "mjpegParser.h"
+
+namespace {
+
+/// HTTP response header of MJPEG stream with given content type
+QByteArray httpHeader(const QByteArray &contentType)
+{
+	return "HTTP/1.0 200 OK\r\nServer: MJPG-Streamer\r\nContent-Type: " + contentType + "\r\n\r\n";
+}
+
+/// JPEG-like bytes, unique for given number. Contains CRLF and dashes, so a parser cutting parts at anything but
+/// the whole delimiter breaks it.
+QByteArray jpeg(int number)
+{
+	const QByteArray body(number * 37 % 500 + 1, static_cast<char>('a' + number % 26));
+	return "\xff\xd8" + body + "\r\n--fram\r\n\xff\xd9";
+}
+
+/// Stream of given frames with given boundary line, with or without Content-Length of parts
+QByteArray stream(const QByteArray &contentType, const QByteArray &boundaryLine, int frames, bool withLength)
+{
+	auto result = httpHeader(contentType);
+	for (int i = 0; i < frames; ++i) {
+		const auto &body = jpeg(i);
+		result += boundaryLine + "\r\nContent-Type: image/jpeg\r\n";
+		if (withLength) {
+			result += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+		}
+
+		result += "X-Timestamp: 1.5\r\n\r\n" + body + "\r\n";
+	}
+
+	// The last part without Content-Length ends with the closing boundary only
+	return result + boundaryLine + "--\r\n";
+}
+
+/// Feeds data to the parser in chunks of given size and returns copies of frames taken
+QVector<QByteArray> parse(MjpegParser &parser, const QByteArray &data, int chunk)
+{
+	QVector<QByteArray> frames;
+	for (int position = 0; position < data.size(); position += chunk) {
+		QBuffer buffer;
+		buffer.setData(data.mid(position, chunk));
+		buffer.open(QIODevice::ReadOnly);
+		if (!parser.read(buffer)) {
+			break;
+		}
+
+		QByteArray frame;
+		while (parser.next(frame)) {
+			frames.append(QByteArray(frame.constData(), frame.size()));
+		}
+	}
+
+	return frames;
+}
+
+/// Pseudo-random bytes, the same on every run
+class Noise
+{
+public:
+	uchar next()
+	{
+		mState ^= mState << 13;
+		mState ^= mState >> 17;
+		mState ^= mState << 5;
+		return static_cast<uchar>(mState >> 24);
+	}
+
+private:
+	quint32 mState { 2463534242u };
+};
+
+/// YUV picture with noise in every plane and rows padded like decoders do, owns its planes
+class NoisePicture
+{
+public:
+	NoisePicture(YuvImage::Layout layout, int width, int height, Noise &noise)
+	{
+		constexpr int padding = 13;
+		const int chromaWidth = (width + 1) / 2;
+		const int chromaHeight = (height + 1) / 2;
+		mImage.layout = layout;
+		mImage.width = width;
+		mImage.height = height;
+		switch (layout) {
+		case YuvImage::Layout::i420:
+			addPlane(width + padding, height, noise);
+			addPlane(chromaWidth + padding, chromaHeight, noise);
+			addPlane(chromaWidth + padding + 3, chromaHeight, noise);
+			break;
+		case YuvImage::Layout::nv12:
+			addPlane(width + padding, height, noise);
+			addPlane(2 * chromaWidth + padding, chromaHeight, noise);
+			break;
+		case YuvImage::Layout::yuyv:
+			addPlane(4 * chromaWidth + padding, height, noise);
+			break;
+		}
+	}
+
+	const YuvImage &image() const
+	{
+		return mImage;
+	}
+
+private:
+	void addPlane(int stride, int rows, Noise &noise)
+	{
+		QByteArray plane(stride * rows, '\0');
+		for (auto &byte : plane) {
+			byte = static_cast<char>(noise.next());
+		}
+
+		const int index = mPlanes.size();
+		mPlanes.append(plane);
+		mImage.data[index] = reinterpret_cast<const uchar *>(mPlanes.last().constData());
+		mImage.stride[index] = stride;
+	}
+
+	/// Planes are not detached after data pointers are taken, since they are only read
+	QVector<QByteArray> mPlanes;
+	YuvImage mImage;
+};
+
+QImage convert(const YuvImage &image, FrameConverter::Kernel kernel)
+{
+	QImage result(image.width, image.height, QImage::Format_RGB32);
+	FrameConverter::convert(image, result.bits(), result.bytesPerLine(), 0, image.height, kernel);
+	return result;
+}
+
+}
+
+/// Checks MjpegParser on streams of different servers and FrameConverter kernels against the scalar one
+class VideoTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void parserCutsPartsByLengthAndBoundary();
+	void parserAcceptsBoundaryVariants();
+	void parserRejectsOtherResponses();
+	void parserRejectsPartWithoutBoundary();
+	void parserKeepsNewestFrameOverRead();
+
+	void kernelsMatchScalar();
+	void parallelConversionMatchesSerial();
+};
+
+void VideoTest::parserCutsPartsByLengthAndBoundary()
+{
+	const QByteArray type = "multipart/x-mixed-replace;boundary=boundarydonotcross";
+	for (const bool withLength : {true, false}) {
+		const auto &data = stream(type, "--boundarydonotcross", 5, withLength);
+		for (const int chunk : {static_cast<int>(data.size()), 1000, 7, 1}) {
+			MjpegParser parser;
+			const auto &frames = parse(parser, data, chunk);
+			QVERIFY2(!parser.hasFailed(), qPrintable(parser.errorString()));
+			QCOMPARE(frames.size(), 5);
+			for (int i = 0; i < frames.size(); ++i) {
+				QCOMPARE(frames[i], jpeg(i));
+			}
+		}
+	}
+}
+
+void VideoTest::parserAcceptsBoundaryVariants()
+{
+	// Content type and boundary line as servers send them
+	const QList<QPair<QByteArray, QByteArray>> variants = {
+		{ "multipart/x-mixed-replace; boundary=\"frame\"", "--frame" }
+		, { "multipart/x-mixed-replace; boundary=frame; charset=binary", "--frame" }
+		, { "multipart/x-mixed-replace; boundary=--frame", "--frame" }
+		, { "multipart/x-mixed-replace; boundary=--frame", "----frame" }
+		, { "multipart/x-mixed-replace; boundary=\"--frame\"", "----frame" }
+	};
+
+	for (const auto &variant : variants) {
+		for (const bool withLength : {true, false}) {
+			MjpegParser parser;
+			const auto &frames = parse(parser, stream(variant.first, variant.second, 3, withLength), 5);
+			QVERIFY2(!parser.hasFailed(), qPrintable(parser.errorString() + ": " + QString::fromLatin1(variant.first)));
+			QCOMPARE(frames.size(), 3);
+			QCOMPARE(frames.last(), jpeg(2));
+		}
+	}
+}
+
+void VideoTest::parserRejectsOtherResponses()
+{
+	MjpegParser parser;
+	QVERIFY(parse(parser, "HTTP/1.0 404 Not Found\r\nContent-Type: text/html\r\n\r\n<html/>", 1000).isEmpty());
+	QVERIFY(parser.hasFailed());
+	QVERIFY2(parser.errorString().contains("404"), qPrintable(parser.errorString()));
+
+	parser.reset();
+	QVERIFY(!parser.hasFailed());
+	QVERIFY(parse(parser, httpHeader("image/jpeg") + jpeg(1), 1000).isEmpty());
+	QVERIFY(parser.hasFailed());
+	QVERIFY2(parser.errorString().contains("instead of MJPEG"), qPrintable(parser.errorString()));
+
+	parser.reset();
+	QVERIFY(parse(parser, httpHeader("multipart/x-mixed-replace") + jpeg(1), 1000).isEmpty());
+	QVERIFY(parser.hasFailed());
+}
+
+void VideoTest::parserRejectsPartWithoutBoundary()
+{
+	QByteArray type = "multipart/x-mixed-replace; boundary=frame";
+	MjpegParser parser;
+	QVERIFY(parse(parser, stream(type, "--other", 2, true), 1000).isEmpty());
+	QVERIFY(parser.hasFailed());
+	QVERIFY2(parser.errorString().contains("boundary"), qPrintable(parser.errorString()));
+
+	// Dashes in the parameter are taken for the boundary line only while the boundary is not confirmed
+	parser.reset();
+	type = "multipart/x-mixed-replace; boundary=--frame";
+	auto data = stream(type, "----frame", 1, true);
+	data.chop(static_cast<int>(sizeof("----frame--\r\n")) - 1);
+	data += stream(type, "--frame", 1, true).mid(httpHeader(type).size());
+	QCOMPARE(parse(parser, data, 1000).size(), 1);
+	QVERIFY(parser.hasFailed());
+}
+
+void VideoTest::parserKeepsNewestFrameOverRead()
+{
+	const auto &data = stream("multipart/x-mixed-replace; boundary=frame", "--frame", 3, true);
+	const int split = data.indexOf(jpeg(2)) + 10;
+	MjpegParser parser;
+	QByteArray frame;
+	QVERIFY(!parser.newest(frame));
+
+	QCOMPARE(parse(parser, data.left(split), split).size(), 2);
+	QVERIFY(parser.newest(frame));
+	QCOMPARE(frame, jpeg(1));
+
+	// Reading the rest moves buffered data, the newest frame shall move along
+	QBuffer buffer;
+	buffer.setData(data.mid(split));
+	buffer.open(QIODevice::ReadOnly);
+	QVERIFY(parser.read(buffer));
+	QVERIFY(parser.newest(frame));
+	QCOMPARE(frame, jpeg(1));
+	QVERIFY(parser.next(frame));
+	QCOMPARE(frame, jpeg(2));
+	QVERIFY(parser.newest(frame));
+	QCOMPARE(frame, jpeg(2));
+
+	parser.reset();
+	QVERIFY(!parser.newest(frame));
+}
+
+void VideoTest::kernelsMatchScalar()
+{
+	Noise noise;
+	const QList<QSize> sizes = { {1, 1}, {2, 2}, {15, 3}, {16, 4}, {17, 5}, {33, 2}, {64, 7}, {101, 9}, {641, 11} };
+	const auto layouts = { YuvImage::Layout::i420, YuvImage::Layout::nv12, YuvImage::Layout::yuyv };
+	int checked = 0;
+	for (const auto kernel : { FrameConverter::Kernel::sse2, FrameConverter::Kernel::avx2 }) {
+		if (!FrameConverter::isSupported(kernel)) {
+			continue;
+		}
+
+		for (const auto layout : layouts) {
+			for (const auto &size : sizes) {
+				const NoisePicture picture(layout, size.width(), size.height(), noise);
+				const auto &expected = convert(picture.image(), FrameConverter::Kernel::scalar);
+				QVERIFY2(convert(picture.image(), kernel) == expected, qPrintable(QString("%1 kernel, layout %2, %3x%4")
+						.arg(FrameConverter::name(kernel)).arg(static_cast<int>(layout))
+						.arg(size.width()).arg(size.height())));
+				++checked;
+			}
+		}
+	}
+
+	if (checked == 0) {
+		QSKIP("No SIMD kernel is supported here");
+	}
+}
+
+void VideoTest::parallelConversionMatchesSerial()
+{
+	Noise noise;
+	QThreadPool pool;
+	pool.setMaxThreadCount(4);
+	for (const auto layout : { YuvImage::Layout::i420, YuvImage::Layout::nv12, YuvImage::Layout::yuyv }) {
+		const NoisePicture picture(layout, 321, 517, noise);
+		const auto &image = picture.image();
+		QImage parallel(image.width, image.height, QImage::Format_RGB32);
+		FrameConverter::convertParallel(image, parallel.bits(), parallel.bytesPerLine(), pool);
+		QVERIFY(parallel == convert(image, FrameConverter::Kernel::scalar));
+		QVERIFY(FrameConverter::toImage(image, &pool) == parallel);
+	}
+}
+
+QTEST_GUILESS_MAIN(VideoTest)
+
+#include "tst_video.moc"
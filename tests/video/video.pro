@@ -0,0 +1,28 @@
+# Copyright 2026 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+include(../tests.pri)
+
+QT = core gui multimedia testlib
+TARGET = tst_video
+
+SOURCES += \
+	$$PWD/tst_video.cpp \
+	$$GAMEPAD_DIR/mjpegParser.cpp \
+	$$GAMEPAD_DIR/frameConverter.cpp
+
+HEADERS += \
+	$$GAMEPAD_DIR/mjpegParser.h \
+	$$GAMEPAD_DIR/frameConverter.h \
+	$$GAMEPAD_DIR/poolTask.h
@@ -7,8 +7,24 @@ SOURCES += \
 	$$PWD/gamepadForm.cpp \
 	$$PWD/connectForm.cpp \
 	$$PWD/connectionManager.cpp \
+	$$PWD/connectionPool.cpp \
+	$$PWD/headlessDriver.cpp \
+	$$PWD/commandCodec.cpp \
+	$$PWD/sendQueue.cpp \
+	$$PWD/linkStatistics.cpp \
 	$$PWD/standardStrategy.cpp \
 	$$PWD/accelerateStrategy.cpp \
+	$$PWD/controlScheduler.cpp \
+	$$PWD/strategyController.cpp \
+	$$PWD/padDeltaFilter.cpp \
+	$$PWD/joystickInput.cpp \
+	$$PWD/inputRecorder.cpp \
+	$$PWD/inputReplay.cpp \
+	$$PWD/frameConverter.cpp \
+	$$PWD/screenshotWorker.cpp \
+	$$PWD/mjpegParser.cpp \
+	$$PWD/mjpegStreamClient.cpp \
+	$$PWD/videoFrameView.cpp \
 	$$PWD/strategy.cpp
 
 TRANSLATIONS += \
@@ -21,9 +37,32 @@ HEADERS += \
 	$$PWD/gamepadForm.h \
 	$$PWD/connectForm.h \
 	$$PWD/connectionManager.h \
+	$$PWD/connectionPool.h \
+	$$PWD/headlessDriver.h \
+	$$PWD/encodedFrame.h \
+	$$PWD/gamepadCommand.h \
+	$$PWD/commandFrame.h \
+	$$PWD/sendQueue.h \
+	$$PWD/linkStatistics.h \
+	$$PWD/commandCodec.h \
 	$$PWD/standardStrategy.h \
 	$$PWD/accelerateStrategy.h \
-	$$PWD/strategy.h
+	$$PWD/controlScheduler.h \
+	$$PWD/strategyController.h \
+	$$PWD/inputQueue.h \
+	$$PWD/padDeltaFilter.h \
+	$$PWD/joystickInput.h \
+	$$PWD/inputRecorder.h \
+	$$PWD/inputReplay.h \
+	$$PWD/frameConverter.h \
+	$$PWD/screenshotWorker.h \
+	$$PWD/poolTask.h \
+	$$PWD/mjpegParser.h \
+	$$PWD/mjpegStreamClient.h \
+	$$PWD/videoFrameView.h \
+	$$PWD/frameMailbox.h \
+	$$PWD/strategy.h \
+	$$PWD/controlKeys.h
 
 FORMS += \
 	$$PWD/gamepadForm.ui \
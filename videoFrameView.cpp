@@ -0,0 +1,56 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "videoFrameView.h"
+
+#include <QtGui/QPainter>
+
+#include "mjpegStreamClient.h"
+
+VideoFrameView::VideoFrameView(MjpegStreamClient *client, QWidget *parent)
+	: QWidget(parent)
+	, mClient(client)
+{
+	// Every pixel is painted, so Qt does not need to clear the background first
+	setAttribute(Qt::WA_OpaquePaintEvent);
+	connect(mClient, &MjpegStreamClient::frameReady, this, [this]() { update(); });
+}
+
+QImage VideoFrameView::frame() const
+{
+	return mFrame;
+}
+
+void VideoFrameView::paintEvent(QPaintEvent *event)
+{
+	Q_UNUSED(event)
+	// Frame decoded while the widget waited for repaint replaces the one it was scheduled for
+	mClient->takeFrame(mFrame);
+
+	QPainter painter(this);
+	painter.fillRect(rect(), Qt::black);
+	if (mFrame.isNull()) {
+		return;
+	}
+
+	QRect target(QPoint(), mFrame.size().scaled(size(), Qt::KeepAspectRatio));
+	target.moveCenter(rect().center());
+	painter.drawImage(target, mFrame);
+}
+
+void VideoFrameView::resizeEvent(QResizeEvent *event)
+{
+	QWidget::resizeEvent(event);
+	mClient->setTargetSize(size() * devicePixelRatioF());
+}
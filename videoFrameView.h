@@ -0,0 +1,45 @@
+/* Copyright 2026 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtGui/QImage>
+#include <QtWidgets/QWidget>
+
+class MjpegStreamClient;
+
+/// Paints video of MjpegStreamClient scaled to fit with aspect ratio kept. Unlike QVideoWidget it has no queue of
+/// its own: the newest decoded frame is taken from the client right before it is painted, and the widget is
+/// repainted once however many frames came between two paints. Client is told the size of the widget, so frames are
+/// decoded no larger than shown.
+class VideoFrameView : public QWidget
+{
+	Q_OBJECT
+	Q_DISABLE_COPY(VideoFrameView)
+
+public:
+	/// Shows video of given client, which shall outlive the widget
+	explicit VideoFrameView(MjpegStreamClient *client, QWidget *parent = nullptr);
+
+	/// Frame shown, null if there was none yet
+	QImage frame() const;
+
+protected:
+	void paintEvent(QPaintEvent *event) override;
+	void resizeEvent(QResizeEvent *event) override;
+
+private:
+	MjpegStreamClient *mClient; // Doesn't have ownership
+	QImage mFrame;
+};